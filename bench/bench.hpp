@@ -0,0 +1,35 @@
+#pragma once
+#include "timer.hpp"
+#include <cstddef>
+#include <cstdio>
+
+namespace hfl::bench
+{
+
+template<typename T>
+inline void do_not_optimize(const T& val)
+{
+#if defined(_MSC_VER)
+    const volatile void* sink = &val;
+    (void)sink;
+#else
+    asm volatile("" : : "r,m"(val) : "memory");
+#endif
+}
+
+template<typename Func>
+inline double run(const char* name, std::size_t iterations, Func&& f)
+{
+    hfl::timer timer{};
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        f(i);
+    }
+    timer.end();
+    const auto ns = static_cast<double>(timer.elapsed_time<std::chrono::nanoseconds>().count());
+    const auto per_op = ns / static_cast<double>(iterations);
+    std::printf("%-40s %10.3f ns/op\n", name, per_op);
+    return per_op;
+}
+
+} // namespace hfl::bench
@@ -0,0 +1,108 @@
+#include "bench.hpp"
+#include "relocatable.hpp"
+#include "rs_result.hpp"
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Calls through non-inlined functions that return results. A trivially
+// copyable rs_result<int, int> is built and returned in a register (x86-64
+// SysV: rax), one with a user-provided copy constructor is written through a
+// hidden pointer to the caller's stack. Compare with
+//
+//   objdump -d --no-show-raw-insn codegen_bench | grep -A8 '<_Z.*parse_'
+
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE [[gnu::noinline]]
+#endif
+
+constexpr std::size_t iterations = 50'000'000;
+
+struct copy_counted_int
+{
+    copy_counted_int(int v) : m_value(v)
+    {
+    }
+
+    copy_counted_int(const copy_counted_int& other) : m_value(other.m_value)
+    {
+    }
+
+    int m_value;
+};
+
+using trivial_result = hfl::rs_result<int, int>;
+using nontrivial_result = hfl::rs_result<copy_counted_int, int>;
+
+static_assert(std::is_trivially_copyable_v<trivial_result>);
+static_assert(!std::is_trivially_copyable_v<nontrivial_result>);
+
+BENCH_NOINLINE trivial_result parse_trivial(int v)
+{
+    return v % 7 == 0 ? trivial_result{hfl::err{v}} : trivial_result{hfl::ok{v}};
+}
+
+BENCH_NOINLINE nontrivial_result parse_nontrivial(int v)
+{
+    return v % 7 == 0 ? nontrivial_result{hfl::err{v}} : nontrivial_result{hfl::ok{copy_counted_int{v}}};
+}
+
+struct owned_int
+{
+    explicit owned_int(int v) : m_value(std::make_unique<int>(v))
+    {
+    }
+
+    std::unique_ptr<int> m_value;
+};
+
+template<>
+struct hfl::is_trivially_relocatable<owned_int> : std::true_type
+{
+};
+
+template<typename T>
+void relocate_loop(const char* name, std::size_t n)
+{
+    using result = hfl::rs_result<T, int>;
+    std::allocator<result> alloc;
+    result* a = alloc.allocate(n);
+    result* b = alloc.allocate(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::construct_at(a + i, hfl::ok{T{static_cast<int>(i)}});
+    }
+    hfl::bench::run(name, 200, [&](std::size_t) {
+        hfl::uninitialized_relocate_n(a, n, b);
+        std::swap(a, b);
+        hfl::bench::do_not_optimize(a);
+    });
+    std::destroy_n(a, n);
+    alloc.deallocate(a, n);
+    alloc.deallocate(b, n);
+}
+
+struct moved_int
+{
+    explicit moved_int(int v) : m_value(std::make_unique<int>(v))
+    {
+    }
+
+    std::unique_ptr<int> m_value;
+};
+
+int main()
+{
+    hfl::bench::run("return trivially copyable rs_result", iterations, [](std::size_t i) {
+        hfl::bench::do_not_optimize(parse_trivial(static_cast<int>(i)).is_ok());
+    });
+    hfl::bench::run("return non-trivial rs_result", iterations, [](std::size_t i) {
+        hfl::bench::do_not_optimize(parse_nontrivial(static_cast<int>(i)).is_ok());
+    });
+    relocate_loop<owned_int>("relocate 100k results, memcpy", 100'000);
+    relocate_loop<moved_int>("relocate 100k results, move", 100'000);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "bench.hpp"
+#include "rs_coroutine.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+constexpr std::size_t iterations = 5'000'000;
+
+using int_result = hfl::rs_result<int, std::string>;
+
+// The inputs are multiples of 4, a quarter of them fail at the last step.
+static int_result checked_step(int v)
+{
+    if ((v & 15) == 15)
+    {
+        return int_result{hfl::err<std::string>{"step failed"}};
+    }
+    return int_result{hfl::ok{v + 1}};
+}
+
+static int throwing_step(int v)
+{
+    if ((v & 15) == 15)
+    {
+        throw std::runtime_error{"step failed"};
+    }
+    return v + 1;
+}
+
+static int_result and_then_chain(int v)
+{
+    return checked_step(v)
+        .and_then([](int x) { return checked_step(x); })
+        .and_then([](int x) { return checked_step(x); })
+        .and_then([](int x) { return checked_step(x); });
+}
+
+static int_result coroutine_chain(int v)
+{
+    const int a = co_await checked_step(v);
+    const int b = co_await checked_step(a);
+    const int c = co_await checked_step(b);
+    co_return co_await checked_step(c);
+}
+
+static int exception_chain(int v)
+{
+    return throwing_step(throwing_step(throwing_step(throwing_step(v))));
+}
+
+int main()
+{
+    hfl::bench::run("and_then chain", iterations, [](std::size_t i) {
+        hfl::bench::do_not_optimize(and_then_chain(static_cast<int>(i * 4)));
+    });
+
+    hfl::bench::run("co_await chain", iterations, [](std::size_t i) {
+        hfl::bench::do_not_optimize(coroutine_chain(static_cast<int>(i * 4)));
+    });
+
+    hfl::bench::run("exception chain", iterations, [](std::size_t i) {
+        try
+        {
+            hfl::bench::do_not_optimize(exception_chain(static_cast<int>(i * 4)));
+        }
+        catch (const std::runtime_error& e)
+        {
+            hfl::bench::do_not_optimize(e);
+        }
+    });
+
+    return 0;
+}
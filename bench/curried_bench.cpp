@@ -0,0 +1,40 @@
+#include "bench.hpp"
+#include "curried.hpp"
+#include <cstddef>
+
+constexpr std::size_t iterations = 50'000'000;
+
+int main()
+{
+    int offset = 7;
+    auto add3 = [offset](int a, int b, int c) { return a + b + c + offset; };
+
+    hfl::bench::run("direct lambda", iterations, [&](std::size_t i) {
+        const int v = static_cast<int>(i);
+        hfl::bench::do_not_optimize(add3(v, v + 1, v + 2));
+    });
+
+    hfl::curried cur(add3);
+    hfl::bench::run("curried<lambda>", iterations, [&](std::size_t i) {
+        const int v = static_cast<int>(i);
+        hfl::bench::do_not_optimize(cur(v)(v + 1)(v + 2));
+    });
+
+    hfl::bench::run("curried<lambda> all at once", iterations, [&](std::size_t i) {
+        const int v = static_cast<int>(i);
+        hfl::bench::do_not_optimize(cur(v, v + 1, v + 2));
+    });
+
+    const auto prefix = cur(offset)(offset);
+    hfl::bench::run("stored curried<lambda> prefix", iterations, [&](std::size_t i) {
+        hfl::bench::do_not_optimize(prefix(static_cast<int>(i)));
+    });
+
+    hfl::curried<int(int, int, int)> erased_cur(add3);
+    hfl::bench::run("curried<std::function>", iterations, [&](std::size_t i) {
+        const int v = static_cast<int>(i);
+        hfl::bench::do_not_optimize(erased_cur(v)(v + 1)(v + 2));
+    });
+
+    return 0;
+}
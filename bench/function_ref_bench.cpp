@@ -0,0 +1,65 @@
+#include "bench.hpp"
+#include "function_ref.hpp"
+#include "rs_result.hpp"
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+// Built twice: once calling rs_result combinators with distinct lambda types,
+// once passing the same lambdas through function_ref. Compare the reported
+// binary sizes for the code size difference, and the ns/op for call overhead.
+#ifndef HFL_BENCH_USE_FUNCTION_REF
+#define HFL_BENCH_USE_FUNCTION_REF 0
+#endif
+
+constexpr std::size_t iterations = 2'000'000;
+constexpr int stage_count = 64;
+
+using result_type = hfl::rs_result<int, std::string>;
+
+template<int N>
+auto make_stage()
+{
+    return [](int v) { return v * 3 + N; };
+}
+
+template<int N>
+auto make_step()
+{
+    return [](int v) { return result_type{hfl::ok<int>{v ^ N}}; };
+}
+
+template<int... Ns>
+int run_stages(const result_type& res, std::integer_sequence<int, Ns...>)
+{
+    int sum = 0;
+#if HFL_BENCH_USE_FUNCTION_REF
+    ((sum += res.map(hfl::function_ref<int(int)>{make_stage<Ns>()}).unwrap_or_default(0)), ...);
+    ((sum += res.and_then(hfl::function_ref<result_type(int)>{make_step<Ns>()}).unwrap_or_default(0)), ...);
+#else
+    ((sum += res.map(make_stage<Ns>()).unwrap_or_default(0)), ...);
+    ((sum += res.and_then(make_step<Ns>()).unwrap_or_default(0)), ...);
+#endif
+    return sum;
+}
+
+int main(int argc, char** argv)
+{
+    const char* name = HFL_BENCH_USE_FUNCTION_REF ? "function_ref combinators" : "template combinators";
+    hfl::bench::run(name, iterations, [](std::size_t i) {
+        const result_type res{hfl::ok<int>{static_cast<int>(i)}};
+        hfl::bench::do_not_optimize(run_stages(res, std::make_integer_sequence<int, stage_count>{}));
+    });
+
+    if (argc > 0)
+    {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(argv[0], ec);
+        if (!ec)
+        {
+            std::printf("%-40s %10ju bytes\n", "binary size", static_cast<std::uintmax_t>(size));
+        }
+    }
+    return 0;
+}
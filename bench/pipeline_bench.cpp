@@ -0,0 +1,55 @@
+#include "bench.hpp"
+#include "rs_result.hpp"
+#include <cstddef>
+#include <string>
+#include <utility>
+
+constexpr std::size_t iterations = 5'000'000;
+
+using result_type = hfl::rs_result<int, std::string>;
+
+constexpr auto step = [](int v) { return result_type{hfl::ok{v + 1}}; };
+constexpr auto map_step = [](int v) { return v + 1; };
+
+template<std::size_t... Is>
+result_type eager(result_type res, std::index_sequence<Is...>)
+{
+    return (std::move(res) | ... | (static_cast<void>(Is), step));
+}
+
+template<std::size_t... Is>
+auto fused(std::index_sequence<Is...>)
+{
+    return hfl::make_pipeline((static_cast<void>(Is), step)...);
+}
+
+template<std::size_t... Is>
+auto fused_map(std::index_sequence<Is...>)
+{
+    return hfl::make_pipeline((static_cast<void>(Is), map_step)...);
+}
+
+template<std::size_t N>
+void run_stages(const char* eager_name, const char* fused_name, const char* fused_map_name)
+{
+    hfl::bench::run(eager_name, iterations, [](std::size_t i) {
+        hfl::bench::do_not_optimize(eager(result_type{hfl::ok{static_cast<int>(i)}}, std::make_index_sequence<N>{}));
+    });
+
+    const auto p = fused(std::make_index_sequence<N>{});
+    hfl::bench::run(fused_name, iterations, [&p](std::size_t i) {
+        hfl::bench::do_not_optimize(p(result_type{hfl::ok{static_cast<int>(i)}}));
+    });
+
+    const auto pm = fused_map(std::make_index_sequence<N>{});
+    hfl::bench::run(fused_map_name, iterations, [&pm](std::size_t i) {
+        hfl::bench::do_not_optimize(pm(result_type{hfl::ok{static_cast<int>(i)}}));
+    });
+}
+
+int main()
+{
+    run_stages<10>("10 stages operator|", "10 stages rs_pipeline", "10 stages rs_pipeline map");
+    run_stages<50>("50 stages operator|", "50 stages rs_pipeline", "50 stages rs_pipeline map");
+    return 0;
+}
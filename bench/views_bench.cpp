@@ -0,0 +1,76 @@
+#include "bench.hpp"
+#include "rs_result.hpp"
+#include "rs_views.hpp"
+#include <cstddef>
+#include <vector>
+
+constexpr std::size_t iterations = 200;
+constexpr std::size_t size = 100'000;
+
+using result_type = hfl::rs_result<int, int>;
+
+static std::vector<result_type> make_input()
+{
+    std::vector<result_type> input;
+    input.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const int v = static_cast<int>(i);
+        input.push_back(i % 5 == 0 ? result_type{hfl::err{v}} : result_type{hfl::ok{v}});
+    }
+    return input;
+}
+
+constexpr auto scale = [](int v) { return v * 3; };
+constexpr auto check = [](int v) { return v % 2 == 0 ? result_type{hfl::ok{v / 2}} : result_type{hfl::err{v}}; };
+
+// What the views replace: one pass and one temporary vector per step.
+static long long staged(const std::vector<result_type>& input)
+{
+    std::vector<result_type> scaled;
+    scaled.reserve(input.size());
+    for (const auto& r : input)
+    {
+        scaled.push_back(r.map(scale));
+    }
+    std::vector<result_type> checked;
+    checked.reserve(scaled.size());
+    for (const auto& r : scaled)
+    {
+        checked.push_back(r.and_then(check));
+    }
+    std::vector<int> values;
+    for (const auto& r : checked)
+    {
+        if (r.is_ok())
+        {
+            values.push_back(r.unwrap_unchecked());
+        }
+    }
+    long long sum = 0;
+    for (int v : values)
+    {
+        sum += v;
+    }
+    return sum;
+}
+
+static long long viewed(const std::vector<result_type>& input)
+{
+    long long sum = 0;
+    for (int v : input | hfl::views::transform_ok(scale) | hfl::views::and_then(check) | hfl::views::oks)
+    {
+        sum += v;
+    }
+    return sum;
+}
+
+int main()
+{
+    const auto input = make_input();
+    hfl::bench::run("100k results, staged vectors", iterations,
+                    [&input](std::size_t) { hfl::bench::do_not_optimize(staged(input)); });
+    hfl::bench::run("100k results, lazy views", iterations,
+                    [&input](std::size_t) { hfl::bench::do_not_optimize(viewed(input)); });
+    return 0;
+}
@@ -0,0 +1,263 @@
+#pragma once
+#include "function_trait.hpp"
+#include "optional.hpp"
+#include "result.hpp"
+#include "rs_result.hpp"
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace hfl
+{
+
+template<typename T>
+struct is_optional : std::false_type
+{
+};
+
+template<typename T>
+struct is_optional<optional<T>> : std::true_type
+{
+};
+
+template<typename T>
+constexpr bool is_optional_v = is_optional<T>::value;
+
+template<typename T>
+struct is_result : std::false_type
+{
+};
+
+template<typename T>
+struct is_result<result<T>> : std::true_type
+{
+};
+
+template<typename T>
+constexpr bool is_result_v = is_result<T>::value;
+
+// Stage outputs a composition unwraps when the next stage wants the payload
+// instead of the whole value: the failure is passed straight to the end.
+template<typename V>
+concept short_circuit_value = is_rs_result_v<std::remove_cvref_t<V>> or is_optional_v<std::remove_cvref_t<V>> or
+                              is_result_v<std::remove_cvref_t<V>>;
+
+template<typename V>
+struct short_circuit_payload
+{
+};
+
+template<typename V>
+    requires is_rs_result_v<std::remove_cvref_t<V>>
+struct short_circuit_payload<V>
+{
+    using raw_type = typename std::remove_cvref_t<V>::raw_ok_type;
+    using type = std::conditional_t<std::is_lvalue_reference_v<V>, const raw_type&, raw_type&&>;
+};
+
+template<typename V>
+    requires is_optional_v<std::remove_cvref_t<V>> or is_result_v<std::remove_cvref_t<V>>
+struct short_circuit_payload<V>
+{
+    using raw_type = std::remove_cvref_t<decltype(std::declval<const V&>().value())>;
+    using type = std::conditional_t<std::is_lvalue_reference_v<V>, const raw_type&, raw_type&&>;
+};
+
+template<typename V>
+using short_circuit_payload_t = typename short_circuit_payload<V>::type;
+
+// Whether a stage returning From can be followed by G, either directly or
+// through the short circuit.
+template<typename From, typename G>
+concept composable_with = std::is_invocable_v<G, From> or
+                          (short_circuit_value<From> and std::is_invocable_v<G, short_circuit_payload_t<From>>);
+
+template<typename F, typename G>
+constexpr bool check_composable()
+{
+    if constexpr (has_function_trait<F> and has_function_trait<G>)
+    {
+        using from_type = typename function_trait<std::decay_t<F>>::return_type;
+        static_assert(function_trait<std::decay_t<G>>::arity == 1,
+                      "a composed stage after the first takes one argument");
+        static_assert(composable_with<from_type, std::decay_t<G>>,
+                      "stage can not take the previous stage's result nor its payload");
+    }
+    return true;
+}
+
+// Callables applied left to right, the same order pipeline uses:
+// compose(f, g)(x) is g(f(x)). The callables are stored by value, so a
+// composition of constexpr callables is itself usable in constant evaluation.
+// A stage returning rs_result, optional or result is followed by a stage that
+// wants its payload the way and_then/map would: failures skip the remaining
+// stages and a plain final value is wrapped back into the same kind.
+template<typename... Funcs>
+class composed
+{
+public:
+    static_assert(sizeof...(Funcs) > 0, "composed needs at least one callable");
+
+    template<typename... Fs>
+        requires(sizeof...(Fs) == sizeof...(Funcs)) and std::is_constructible_v<std::tuple<Funcs...>, Fs&&...>
+    constexpr explicit composed(std::in_place_t, Fs&&... fs) : m_funcs(std::forward<Fs>(fs)...)
+    {
+    }
+
+    template<typename... Fs>
+    constexpr explicit composed(std::in_place_t, std::tuple<Fs...>&& funcs) : m_funcs(std::move(funcs))
+    {
+    }
+
+    template<typename... Args>
+    constexpr decltype(auto) operator()(Args&&... args) const&
+    {
+        return invoke_from<0>(m_funcs, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    constexpr decltype(auto) operator()(Args&&... args) &&
+    {
+        return invoke_from<0>(std::move(m_funcs), std::forward<Args>(args)...);
+    }
+
+    template<typename G>
+    constexpr auto then(G&& g) const& -> composed<Funcs..., std::decay_t<G>>
+    {
+        check_composable<std::tuple_element_t<sizeof...(Funcs) - 1, std::tuple<Funcs...>>, G>();
+        return composed<Funcs..., std::decay_t<G>>{
+            std::in_place, std::tuple_cat(m_funcs, std::tuple<std::decay_t<G>>{std::forward<G>(g)})};
+    }
+
+    template<typename G>
+    constexpr auto then(G&& g) && -> composed<Funcs..., std::decay_t<G>>
+    {
+        check_composable<std::tuple_element_t<sizeof...(Funcs) - 1, std::tuple<Funcs...>>, G>();
+        return composed<Funcs..., std::decay_t<G>>{
+            std::in_place, std::tuple_cat(std::move(m_funcs), std::tuple<std::decay_t<G>>{std::forward<G>(g)})};
+    }
+
+private:
+    static constexpr size_t func_count = sizeof...(Funcs);
+
+    template<size_t I, typename FuncsTuple, typename... Args>
+    static constexpr decltype(auto) invoke_from(FuncsTuple&& funcs, Args&&... args)
+    {
+        if constexpr (std::is_invocable_v<decltype(std::get<I>(std::forward<FuncsTuple>(funcs))), Args&&...>)
+        {
+            if constexpr (I + 1 == func_count)
+            {
+                return std::invoke(std::get<I>(std::forward<FuncsTuple>(funcs)), std::forward<Args>(args)...);
+            }
+            else
+            {
+                return invoke_from<I + 1>(std::forward<FuncsTuple>(funcs),
+                                          std::invoke(std::get<I>(std::forward<FuncsTuple>(funcs)),
+                                                      std::forward<Args>(args)...));
+            }
+        }
+        else
+        {
+            static_assert(sizeof...(Args) == 1, "only a single stage result can be short circuited");
+            return short_circuit<I>(std::forward<FuncsTuple>(funcs), std::forward<Args>(args)...);
+        }
+    }
+
+    template<size_t I, typename FuncsTuple, typename V>
+    static constexpr auto short_circuit(FuncsTuple&& funcs, V&& val)
+    {
+        using value_type = std::remove_cvref_t<V>;
+        static_assert(short_circuit_value<V>, "stage can not take the previous stage's result");
+        using next_type = std::remove_cvref_t<decltype(invoke_from<I>(std::forward<FuncsTuple>(funcs),
+                                                                      std::declval<short_circuit_payload_t<V>>()))>;
+
+        if constexpr (is_rs_result_v<value_type>)
+        {
+            using err_value_type = typename value_type::raw_err_type;
+            using return_type =
+                std::conditional_t<is_rs_result_v<next_type>, next_type, rs_result<next_type, err_value_type>>;
+            return std::forward<V>(val).match(
+                [&funcs](auto&& v) -> return_type {
+                    if constexpr (is_rs_result_v<next_type>)
+                    {
+                        return invoke_from<I>(std::forward<FuncsTuple>(funcs), std::forward<decltype(v)>(v).m_value);
+                    }
+                    else
+                    {
+                        return return_type{ok<next_type>{
+                            invoke_from<I>(std::forward<FuncsTuple>(funcs), std::forward<decltype(v)>(v).m_value)}};
+                    }
+                },
+                [](auto&& e) -> return_type { return return_type{std::forward<decltype(e)>(e)}; });
+        }
+        else if constexpr (is_optional_v<value_type>)
+        {
+            using return_type = std::conditional_t<is_optional_v<next_type>, next_type, optional<next_type>>;
+            if (!val.has_value())
+            {
+                return return_type{std::nullopt};
+            }
+            return return_type{invoke_from<I>(std::forward<FuncsTuple>(funcs), *std::forward<V>(val))};
+        }
+        else
+        {
+            using return_type = std::conditional_t<is_result_v<next_type>, next_type, result<next_type>>;
+            if (!val.has_value())
+            {
+                return return_type{val.error_code()};
+            }
+            return return_type{invoke_from<I>(std::forward<FuncsTuple>(funcs), std::forward<V>(val).value())};
+        }
+    }
+
+    template<typename...>
+    friend class composed;
+
+    std::tuple<Funcs...> m_funcs;
+};
+
+template<typename... Funcs>
+constexpr bool check_composable_chain()
+{
+    return []<size_t... Is>(std::index_sequence<Is...>) {
+        return (check_composable<std::tuple_element_t<Is, std::tuple<Funcs...>>,
+                                 std::tuple_element_t<Is + 1, std::tuple<Funcs...>>>() and
+                ... and true);
+    }(std::make_index_sequence<sizeof...(Funcs) - 1>{});
+}
+
+template<typename... Funcs>
+    requires(sizeof...(Funcs) > 0)
+constexpr auto compose(Funcs&&... fs) -> composed<std::decay_t<Funcs>...>
+{
+    static_assert(check_composable_chain<std::decay_t<Funcs>...>());
+    return composed<std::decay_t<Funcs>...>{std::in_place, std::forward<Funcs>(fs)...};
+}
+
+// f >> g >> h builds compose(f, g, h). A composed value on the left picks the
+// operator up through ADL, for two plain callables use namespace hfl like
+// operator^ in optional_function.hpp. Operators can not be overloaded for two
+// function pointers, start such a chain with compose(f).
+template<typename... Funcs, typename G>
+constexpr auto operator>>(const composed<Funcs...>& c, G&& g) -> composed<Funcs..., std::decay_t<G>>
+{
+    return c.then(std::forward<G>(g));
+}
+
+template<typename... Funcs, typename G>
+constexpr auto operator>>(composed<Funcs...>&& c, G&& g) -> composed<Funcs..., std::decay_t<G>>
+{
+    return std::move(c).then(std::forward<G>(g));
+}
+
+template<typename F, typename G>
+    requires has_function_trait<F> and has_function_trait<G> and
+             composable_with<typename function_trait<std::decay_t<F>>::return_type, std::decay_t<G>>
+constexpr auto operator>>(F&& f, G&& g) -> composed<std::decay_t<F>, std::decay_t<G>>
+{
+    return compose(std::forward<F>(f), std::forward<G>(g));
+}
+
+} // namespace hfl
@@ -1,99 +1,189 @@
 #pragma once
+#include "function_trait.hpp"
 #include "hfl_concept.hpp"
 #include <functional>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace hfl
 {
 
-template<typename Func>
-using function = std::function<Func>;
+template<size_t N, typename Tuple, typename Seq = std::make_index_sequence<N>>
+struct tuple_prefix;
 
-template<size_t Rem, typename Sig>
-struct curried_helper
+template<size_t N, typename... Ts, size_t... Is>
+struct tuple_prefix<N, std::tuple<Ts...>, std::index_sequence<Is...>>
 {
+    using type = std::tuple<std::tuple_element_t<Is, std::tuple<Ts...>>...>;
 };
 
-template<size_t Rem, typename Ret, typename... Args>
-struct curried_helper<Rem, Ret(Args...)>
+template<size_t N, typename Tuple>
+using tuple_prefix_t = typename tuple_prefix<N, Tuple>::type;
+
+// How a curried parameter of type T is kept while waiting for the rest of
+// the arguments: by value, except for non-const lvalue references which
+// must keep referring to the caller's object.
+template<typename T>
+struct curried_storage
 {
-    using args_tuple_type = std::tuple<Args...>;
-    using function_type = function<Ret(Args...)>;
-    using arg_type = std::tuple_element_t<std::tuple_size_v<args_tuple_type> - Rem, args_tuple_type>;
+    using type = std::remove_cvref_t<T>;
+};
 
-    constexpr curried_helper(function_type& f, args_tuple_type& args) : m_f(f), m_args(args)
-    {
-    }
+template<typename T>
+struct curried_storage<T&>
+{
+    using type = std::reference_wrapper<T>;
+};
 
-    constexpr auto operator()(const std::remove_cvref_t<arg_type>& arg)
-    {
-        std::get<std::tuple_size_v<args_tuple_type> - Rem>(m_args) = arg;
-        return curried_helper<Rem - 1, Ret(Args...)>(m_f, m_args);
-    }
-    function_type& m_f;
-    args_tuple_type& m_args;
+template<typename T>
+struct curried_storage<const T&>
+{
+    using type = T;
 };
 
-template<typename Ret, typename... Args>
-struct curried_helper<1, Ret(Args...)>
+template<typename T>
+using curried_storage_t = typename curried_storage<T>::type;
+
+template<typename Func, typename Tuple, typename... Tail>
+struct is_invocable_with_tuple;
+
+template<typename Func, typename... Ts, typename... Tail>
+struct is_invocable_with_tuple<Func, const std::tuple<Ts...>&, Tail...>
+    : std::is_invocable<Func, const Ts&..., Tail...>
+{
+};
+
+template<typename Func, typename... Ts, typename... Tail>
+struct is_invocable_with_tuple<Func, std::tuple<Ts...>&&, Tail...> : std::is_invocable<Func, Ts&&..., Tail...>
+{
+};
+
+template<typename Func, typename Tuple, typename... Tail>
+constexpr bool is_invocable_with_tuple_v = is_invocable_with_tuple<Func, Tuple, Tail...>::value;
+
+// Whether As... can be bound to the parameters starting at Offset.
+template<size_t Offset, typename StorageTuple, typename... As>
+constexpr bool curried_accepts_v = []<size_t... Is>(std::index_sequence<Is...>) {
+    return (std::is_constructible_v<std::tuple_element_t<Offset + Is, StorageTuple>, As&&> and ...);
+}(std::index_sequence_for<As...>{});
+
+// A partial application of F waiting for its last Rem arguments.
+// The callable and the bound arguments are held by value and never written
+// after construction, so a partial can be stored, reused with different
+// trailing arguments and shared between threads. Applying an rvalue partial
+// moves the callable and the bound arguments onwards instead of copying them.
+// Several leading arguments can be given in one call, cur(a, b)(c), which
+// skips the intermediate partials entirely.
+template<size_t Rem, typename Sig, typename F = std::function<Sig>>
+struct curried_helper
+{
+};
+
+template<size_t Rem, typename Ret, typename... Args, typename F>
+struct curried_helper<Rem, Ret(Args...), F>
 {
     using args_tuple_type = std::tuple<Args...>;
-    using function_type = function<Ret(Args...)>;
-    using arg_type = std::tuple_element_t<std::tuple_size_v<args_tuple_type> - 1, args_tuple_type>;
+    using function_type = F;
+    static constexpr size_t bound_count = sizeof...(Args) - Rem;
+    using bound_tuple_type = tuple_prefix_t<bound_count, std::tuple<curried_storage_t<Args>...>>;
+    using arg_type = std::tuple_element_t<bound_count, args_tuple_type>;
+
+    template<typename Func, typename... Bound>
+        requires std::is_constructible_v<function_type, Func&&> and
+                 std::is_constructible_v<bound_tuple_type, Bound&&...>
+    constexpr explicit curried_helper(std::in_place_t, Func&& f, Bound&&... bound)
+        : m_f(std::forward<Func>(f)), m_args(std::forward<Bound>(bound)...)
+    {
+    }
 
-    constexpr curried_helper(function_type& f, args_tuple_type& args) : m_f(f), m_args(args)
+    template<typename... As>
+        requires(sizeof...(As) >= 1 and sizeof...(As) <= Rem) and
+                curried_accepts_v<bound_count, std::tuple<curried_storage_t<Args>...>, As...> and
+                ((sizeof...(As) < Rem and std::is_copy_constructible_v<function_type>) or
+                 is_invocable_with_tuple_v<const function_type&, const bound_tuple_type&, As&&...>)
+    constexpr decltype(auto) operator()(As&&... as) const&
     {
+        return std::apply(
+            [this, &as...](const auto&... bound) -> decltype(auto) {
+                if constexpr (sizeof...(As) == Rem)
+                {
+                    return std::invoke(m_f, bound..., std::forward<As>(as)...);
+                }
+                else
+                {
+                    return curried_helper<Rem - sizeof...(As), Ret(Args...), F>{std::in_place, m_f, bound...,
+                                                                                std::forward<As>(as)...};
+                }
+            },
+            m_args);
     }
 
-    constexpr decltype(auto) operator()(const std::remove_cvref_t<arg_type>& arg)
+    template<typename... As>
+        requires(sizeof...(As) >= 1 and sizeof...(As) <= Rem) and
+                curried_accepts_v<bound_count, std::tuple<curried_storage_t<Args>...>, As...> and
+                (sizeof...(As) < Rem or is_invocable_with_tuple_v<function_type&&, bound_tuple_type&&, As&&...>)
+    constexpr decltype(auto) operator()(As&&... as) &&
     {
-        std::get<std::tuple_size_v<args_tuple_type> - 1>(m_args) = arg;
-        return std::apply(m_f, m_args);
+        return std::apply(
+            [this, &as...](auto&&... bound) -> decltype(auto) {
+                if constexpr (sizeof...(As) == Rem)
+                {
+                    return std::invoke(std::move(m_f), std::forward<decltype(bound)>(bound)...,
+                                       std::forward<As>(as)...);
+                }
+                else
+                {
+                    return curried_helper<Rem - sizeof...(As), Ret(Args...), F>{
+                        std::in_place, std::move(m_f), std::forward<decltype(bound)>(bound)...,
+                        std::forward<As>(as)...};
+                }
+            },
+            std::move(m_args));
     }
 
 private:
-    function_type& m_f;
-    args_tuple_type& m_args;
+    function_type m_f;
+    bound_tuple_type m_args;
 };
 
-template<typename Sig>
+// F defaults to the type-erased std::function, use the deduction guide below
+// (or spell F out) to keep the concrete callable and let the call inline.
+// A move-only F such as hfl::function is fine as long as every partial that
+// is not the last one is applied as an rvalue.
+template<typename Sig, typename F = std::function<Sig>>
 struct curried
 {
 };
 
-template<typename Ret, typename... Args>
-struct curried<Ret(Args...)>
+template<typename Ret, typename... Args, typename F>
+struct curried<Ret(Args...), F> : public curried_helper<sizeof...(Args), Ret(Args...), F>
 {
+    using base_type = curried_helper<sizeof...(Args), Ret(Args...), F>;
     using args_tuple_type = std::tuple<Args...>;
     using first_arg_type = std::tuple_element_t<0, args_tuple_type>;
-    using function_type = function<Ret(Args...)>;
+    using function_type = F;
 
     template<typename Func>
-        requires callable_with_tuple_args<Func, args_tuple_type>
-    constexpr curried(Func&& f) : m_f(std::forward<Func>(f)), m_tuple_args()
+        requires(!std::is_same_v<std::remove_cvref_t<Func>, curried>) and
+                callable_with_tuple_args<Func, args_tuple_type>
+    constexpr curried(Func&& f) : base_type(std::in_place, std::forward<Func>(f))
     {
     }
 
-    constexpr decltype(auto) operator()(first_arg_type arg)
-    {
-        if constexpr (std::tuple_size_v<args_tuple_type> == 1)
-        {
-            auto& arg_val = std::get<0>(m_tuple_args);
-            arg_val = arg;
-            return std::apply(m_f, m_tuple_args);
-        }
-        else
-        {
-            auto& arg_val = std::get<0>(m_tuple_args);
-            arg_val = arg;
-            return curried_helper<std::tuple_size_v<args_tuple_type> - 1, Ret(Args...)>{m_f, m_tuple_args};
-        }
-    }
-
-private:
-    function_type m_f;
-    args_tuple_type m_tuple_args;
+    using base_type::operator();
 };
 
+template<typename Func>
+curried(Func) -> curried<typename function_trait<std::decay_t<Func>>::signature_type, std::decay_t<Func>>;
+
+template<typename Func, typename... Bound>
+    requires(sizeof...(Bound) < function_trait<std::decay_t<Func>>::arity)
+constexpr auto bind_front(Func&& f, Bound&&... bound)
+{
+    using trait_type = function_trait<std::decay_t<Func>>;
+    return curried_helper<trait_type::arity - sizeof...(Bound), typename trait_type::signature_type,
+                          std::decay_t<Func>>{std::in_place, std::forward<Func>(f), std::forward<Bound>(bound)...};
+}
 
-} // namespace hfl
\ No newline at end of file
+} // namespace hfl
@@ -0,0 +1,278 @@
+#pragma once
+#include "static_error.hpp"
+#include <cstddef>
+#include <memory>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hfl
+{
+
+// One "while doing X" frame of an error's context chain. Nodes are immutable
+// once linked, so chains of different errors may share their tails.
+struct context_node
+{
+    std::string_view m_message;
+    std::source_location m_location;
+    const context_node* m_next;
+};
+
+// Bump allocator for context_node. Nodes are handed out in O(1) from fixed
+// size blocks and are only released all at once by reset() or when the arena
+// is destroyed, so errors that point into it must not outlive either. Not
+// thread-safe, every thread allocates from its own current() arena.
+class context_arena
+{
+public:
+    static constexpr size_t block_size = 256;
+
+    context_arena() = default;
+    context_arena(const context_arena&) = delete;
+    context_arena& operator=(const context_arena&) = delete;
+
+    const context_node* push(std::string_view message, const std::source_location& location,
+                             const context_node* next)
+    {
+        if (m_used == block_size or m_blocks.empty()) [[unlikely]]
+        {
+            next_block();
+        }
+        context_node* node = m_blocks[m_block].get() + m_used++;
+        *node = context_node{message, location, next};
+        return node;
+    }
+
+    // Forgets every node but keeps the blocks for reuse.
+    void reset() noexcept
+    {
+        m_block = 0;
+        m_used = 0;
+    }
+
+    size_t node_count() const noexcept
+    {
+        return m_blocks.empty() ? 0 : m_block * block_size + m_used;
+    }
+
+    // The arena context() allocates from on the calling thread: the innermost
+    // live context_arena_scope, or a thread_local arena by default. Long-running
+    // threads should use a per-request scope so the default arena does not grow
+    // without bound.
+    static context_arena& current() noexcept
+    {
+        context_arena* arena = current_slot();
+        return arena != nullptr ? *arena : thread_default();
+    }
+
+private:
+    friend class context_arena_scope;
+
+    void next_block()
+    {
+        if (!m_blocks.empty())
+        {
+            ++m_block;
+        }
+        if (m_block == m_blocks.size())
+        {
+            m_blocks.push_back(std::make_unique_for_overwrite<context_node[]>(block_size));
+        }
+        m_used = 0;
+    }
+
+    static context_arena*& current_slot() noexcept
+    {
+        thread_local context_arena* arena = nullptr;
+        return arena;
+    }
+
+    static context_arena& thread_default() noexcept
+    {
+        thread_local context_arena arena;
+        return arena;
+    }
+
+    std::vector<std::unique_ptr<context_node[]>> m_blocks;
+    size_t m_block{0};
+    size_t m_used{0};
+};
+
+// Makes arena the calling thread's current() arena until the scope ends.
+class context_arena_scope
+{
+public:
+    explicit context_arena_scope(context_arena& arena) noexcept
+        : m_previous(std::exchange(context_arena::current_slot(), &arena))
+    {
+    }
+
+    context_arena_scope(const context_arena_scope&) = delete;
+    context_arena_scope& operator=(const context_arena_scope&) = delete;
+
+    ~context_arena_scope()
+    {
+        context_arena::current_slot() = m_previous;
+    }
+
+private:
+    context_arena* m_previous;
+};
+
+template<typename E>
+void append_error_message(std::string& out, const E& e)
+{
+    if constexpr (requires { e.message(); })
+    {
+        out += e.message();
+    }
+    else
+    {
+        append_error_arg(out, e);
+    }
+}
+
+// An error plus the contexts the layers it crossed added to it, one pointer on
+// top of E. Adding a context links one arena node and builds no string, the
+// chain is only formatted by render():
+//
+//   auto cfg = read_file(path).map_err(hfl::add_context("while loading config"));
+//   ...
+//   std::cerr << cfg.unwrap_err().render();
+//
+// Context messages are stored as views, pass string literals or strings that
+// outlive the error.
+template<typename E>
+class context_error
+{
+public:
+    using error_type = E;
+
+    constexpr explicit context_error(E error) noexcept(std::is_nothrow_move_constructible_v<E>)
+        : m_error(std::move(error))
+    {
+    }
+
+    context_error context(std::string_view message,
+                          const std::source_location& location = std::source_location::current()) const&
+    {
+        return context_error{m_error, context_arena::current().push(message, location, m_head)};
+    }
+
+    context_error context(std::string_view message,
+                          const std::source_location& location = std::source_location::current()) &&
+    {
+        m_head = context_arena::current().push(message, location, m_head);
+        return std::move(*this);
+    }
+
+    constexpr const E& error() const& noexcept
+    {
+        return m_error;
+    }
+
+    constexpr E&& error() && noexcept
+    {
+        return std::move(m_error);
+    }
+
+    // Newest context first, null when there is none.
+    constexpr const context_node* head() const noexcept
+    {
+        return m_head;
+    }
+
+    size_t depth() const noexcept
+    {
+        size_t n = 0;
+        for (const context_node* node = m_head; node != nullptr; node = node->m_next)
+        {
+            ++n;
+        }
+        return n;
+    }
+
+    // The error's message followed by one line per context, innermost first:
+    //
+    //   key 42 not found in table
+    //     while loading config (config.cpp:12)
+    //     while starting server (main.cpp:40)
+    std::string render(bool with_locations = true) const
+    {
+        std::string out;
+        append_error_message(out, m_error);
+        append_contexts(out, m_head, with_locations);
+        return out;
+    }
+
+private:
+    constexpr context_error(const E& error, const context_node* head) : m_error(error), m_head(head)
+    {
+    }
+
+    static void append_contexts(std::string& out, const context_node* node, bool with_locations)
+    {
+        if (node == nullptr)
+        {
+            return;
+        }
+        append_contexts(out, node->m_next, with_locations);
+        out += "\n  ";
+        out += node->m_message;
+        if (with_locations and node->m_location.line() != 0)
+        {
+            out += " (";
+            out += node->m_location.file_name();
+            out += ':';
+            append_error_arg(out, node->m_location.line());
+            out += ')';
+        }
+    }
+
+    E m_error;
+    const context_node* m_head{nullptr};
+};
+
+template<typename T>
+struct is_context_error : std::false_type
+{
+};
+
+template<typename E>
+struct is_context_error<context_error<E>> : std::true_type
+{
+};
+
+// Function object for map_err that wraps the error in a context_error (or
+// extends the chain of one) with message and the call site of add_context.
+class add_context
+{
+public:
+    explicit add_context(std::string_view message,
+                         const std::source_location& location = std::source_location::current()) noexcept
+        : m_message(message), m_location(location)
+    {
+    }
+
+    template<typename E>
+    auto operator()(E&& error) const
+    {
+        if constexpr (is_context_error<std::remove_cvref_t<E>>::value)
+        {
+            return std::forward<E>(error).context(m_message, m_location);
+        }
+        else
+        {
+            return context_error<std::remove_cvref_t<E>>{std::forward<E>(error)}.context(m_message, m_location);
+        }
+    }
+
+private:
+    std::string_view m_message;
+    std::source_location m_location;
+};
+
+} // namespace hfl
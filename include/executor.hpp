@@ -0,0 +1,416 @@
+#pragma once
+#include "hfl_config.hpp"
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hfl
+{
+
+// Chase-Lev work-stealing deque. The owning worker pushes and pops at the
+// bottom without locking, other workers steal from the top with a single CAS.
+// The ring grows when full; retired rings are kept until the deque is
+// destroyed because a concurrent thief may still read from them.
+template<typename T>
+class work_stealing_deque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "work_stealing_deque holds trivially copyable items");
+
+public:
+    explicit work_stealing_deque(size_t capacity = 256) : m_ring(new ring(round_up_pow2(capacity)))
+    {
+        m_rings.emplace_back(m_ring.load(std::memory_order_relaxed));
+    }
+
+    work_stealing_deque(const work_stealing_deque&) = delete;
+    work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+    // Owner only.
+    void push(T item)
+    {
+        const int64_t b = m_bottom.load(std::memory_order_relaxed);
+        const int64_t t = m_top.load(std::memory_order_acquire);
+        ring* r = m_ring.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(r->m_capacity) - 1) [[unlikely]]
+        {
+            r = grow(r, b, t);
+        }
+        r->put(b, item);
+        m_bottom.store(b + 1, std::memory_order_release);
+    }
+
+    // Owner only, newest item first.
+    std::optional<T> pop()
+    {
+        const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        ring* r = m_ring.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        if (t > b)
+        {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        T item = r->get(b);
+        if (t == b)
+        {
+            // Last item, race the thieves for it.
+            const bool won =
+                m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won)
+            {
+                return std::nullopt;
+            }
+        }
+        return item;
+    }
+
+    // Any thread, oldest item first. Fails spuriously when it loses a race.
+    std::optional<T> steal()
+    {
+        int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = m_bottom.load(std::memory_order_acquire);
+        if (t >= b)
+        {
+            return std::nullopt;
+        }
+        T item = m_ring.load(std::memory_order_acquire)->get(t);
+        if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return std::nullopt;
+        }
+        return item;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct ring
+    {
+        explicit ring(size_t capacity) : m_capacity(capacity), m_slots(new std::atomic<T>[capacity])
+        {
+        }
+
+        T get(int64_t i) const noexcept
+        {
+            return m_slots[static_cast<size_t>(i) & (m_capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t i, T item) noexcept
+        {
+            m_slots[static_cast<size_t>(i) & (m_capacity - 1)].store(item, std::memory_order_relaxed);
+        }
+
+        size_t m_capacity;
+        std::unique_ptr<std::atomic<T>[]> m_slots;
+    };
+
+    static size_t round_up_pow2(size_t n) noexcept
+    {
+        size_t capacity = 2;
+        while (capacity < n)
+        {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    ring* grow(ring* old, int64_t bottom, int64_t top)
+    {
+        auto* bigger = new ring(old->m_capacity * 2);
+        m_rings.emplace_back(bigger);
+        for (int64_t i = top; i < bottom; ++i)
+        {
+            bigger->put(i, old->get(i));
+        }
+        m_ring.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<int64_t> m_top{0};
+    alignas(64) std::atomic<int64_t> m_bottom{0};
+    std::atomic<ring*> m_ring;
+    std::vector<std::unique_ptr<ring>> m_rings;
+};
+
+// Fire-and-forget coroutine, used to run plain callables on the executor.
+struct detached_task
+{
+    struct promise_type
+    {
+        detached_task get_return_object() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept
+        {
+        }
+
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+// Thread pool where every worker owns a work_stealing_deque. Work posted from
+// a worker goes to its own deque and is run newest first, idle workers steal
+// the oldest work of the others. Work posted from other threads goes through
+// a shared injection queue. Destroying the executor runs the remaining work
+// and joins the workers.
+class work_stealing_executor
+{
+public:
+    explicit work_stealing_executor(size_t thread_count = std::thread::hardware_concurrency())
+    {
+        thread_count = thread_count == 0 ? 1 : thread_count;
+        m_workers.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            m_workers.push_back(std::make_unique<worker>());
+        }
+#ifdef HFL_NO_EXCEPTIONS
+        start_threads();
+#else
+        try
+        {
+            start_threads();
+        }
+        catch (...)
+        {
+            // Joinable std::threads must not be destroyed, stop the ones that
+            // did start.
+            stop_and_join();
+            throw;
+        }
+#endif
+    }
+
+    work_stealing_executor(const work_stealing_executor&) = delete;
+    work_stealing_executor& operator=(const work_stealing_executor&) = delete;
+
+    ~work_stealing_executor()
+    {
+        stop_and_join();
+    }
+
+    size_t thread_count() const noexcept
+    {
+        return m_workers.size();
+    }
+
+    // Whether the calling thread is one of this executor's workers.
+    bool running_in_this_thread() const noexcept
+    {
+        return current_executor == this;
+    }
+
+    void post(std::coroutine_handle<> handle)
+    {
+        if (current_executor == this)
+        {
+            m_workers[current_index]->m_deque.push(handle.address());
+        }
+        else
+        {
+            std::lock_guard lock{m_injected_mutex};
+            m_injected.push_back(handle.address());
+        }
+        wake();
+    }
+
+    template<typename Func>
+        requires std::is_invocable_v<std::decay_t<Func>&>
+    void execute(Func&& f)
+    {
+        [](work_stealing_executor& ex, std::decay_t<Func> func) -> detached_task {
+            co_await ex.schedule();
+            std::invoke(func);
+        }(*this, std::forward<Func>(f));
+    }
+
+    class schedule_awaiter
+    {
+    public:
+        explicit schedule_awaiter(work_stealing_executor& ex) noexcept : m_executor(ex)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const
+        {
+            m_executor.post(handle);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+    private:
+        work_stealing_executor& m_executor;
+    };
+
+    // co_await ex.schedule() continues the coroutine on a worker.
+    schedule_awaiter schedule() noexcept
+    {
+        return schedule_awaiter{*this};
+    }
+
+private:
+    struct worker
+    {
+        work_stealing_deque<void*> m_deque;
+        std::thread m_thread;
+    };
+
+    void start_threads()
+    {
+        for (size_t i = 0; i < m_workers.size(); ++i)
+        {
+            m_workers[i]->m_thread = std::thread([this, i] { run(i); });
+        }
+    }
+
+    void stop_and_join()
+    {
+        m_stop.store(true, std::memory_order_seq_cst);
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        m_epoch.notify_all();
+        for (auto& w : m_workers)
+        {
+            if (w->m_thread.joinable())
+            {
+                w->m_thread.join();
+            }
+        }
+    }
+
+    // A steal that lost a race returns nothing although work is queued, so a
+    // worker only leaves on stop once every queue is seen empty.
+    bool has_queued_work()
+    {
+        for (const auto& w : m_workers)
+        {
+            if (!w->m_deque.empty())
+            {
+                return true;
+            }
+        }
+        std::lock_guard lock{m_injected_mutex};
+        return !m_injected.empty();
+    }
+
+    void wake()
+    {
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_seq_cst) > 0)
+        {
+            m_epoch.notify_one();
+        }
+    }
+
+    void* take(size_t index)
+    {
+        if (auto item = m_workers[index]->m_deque.pop())
+        {
+            return *item;
+        }
+        {
+            std::lock_guard lock{m_injected_mutex};
+            if (!m_injected.empty())
+            {
+                void* item = m_injected.front();
+                m_injected.pop_front();
+                return item;
+            }
+        }
+        const size_t n = m_workers.size();
+        for (size_t k = 1; k < n; ++k)
+        {
+            if (auto item = m_workers[(index + k) % n]->m_deque.steal())
+            {
+                return *item;
+            }
+        }
+        return nullptr;
+    }
+
+    void run(size_t index)
+    {
+        current_executor = this;
+        current_index = index;
+        while (true)
+        {
+            if (void* item = take(index))
+            {
+                std::coroutine_handle<>::from_address(item).resume();
+                continue;
+            }
+
+            m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+            const uint32_t epoch = m_epoch.load(std::memory_order_seq_cst);
+            if (void* item = take(index))
+            {
+                m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+                std::coroutine_handle<>::from_address(item).resume();
+                continue;
+            }
+            if (m_stop.load(std::memory_order_seq_cst))
+            {
+                m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+                if (has_queued_work())
+                {
+                    continue;
+                }
+                break;
+            }
+            m_epoch.wait(epoch, std::memory_order_seq_cst);
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+        }
+        current_executor = nullptr;
+    }
+
+    static inline thread_local work_stealing_executor* current_executor = nullptr;
+    static inline thread_local size_t current_index = 0;
+
+    std::vector<std::unique_ptr<worker>> m_workers;
+    std::mutex m_injected_mutex;
+    std::deque<void*> m_injected;
+    std::atomic<uint32_t> m_epoch{0};
+    std::atomic<uint32_t> m_sleeping{0};
+    std::atomic<bool> m_stop{false};
+};
+
+} // namespace hfl
@@ -0,0 +1,226 @@
+#pragma once
+#include "hfl_config.hpp"
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hfl
+{
+
+constexpr size_t function_default_capacity = 3 * sizeof(void*);
+
+// Move-only callable wrapper. Callables up to Capacity bytes that are nothrow
+// move constructible live in the inline buffer, bigger ones go to the heap
+// unless HeapFallback is false, in which case they are rejected at compile
+// time. A noexcept signature only accepts nothrow invocable callables.
+template<typename Sig, size_t Capacity = function_default_capacity, bool HeapFallback = true>
+class basic_function;
+
+template<bool Noexcept, size_t Capacity, bool HeapFallback, typename R, typename... Args>
+class function_base
+{
+    static_assert(Capacity >= sizeof(void*), "function capacity must at least hold a pointer");
+
+public:
+    template<typename F>
+    static constexpr bool stored_inline = sizeof(F) <= Capacity and alignof(F) <= alignof(std::max_align_t) and
+                                          std::is_nothrow_move_constructible_v<F>;
+
+    template<typename F>
+    static constexpr bool accepts =
+        Noexcept ? std::is_nothrow_invocable_r_v<R, F&, Args...> : std::is_invocable_r_v<R, F&, Args...>;
+
+    function_base() noexcept = default;
+
+    function_base(std::nullptr_t) noexcept
+    {
+    }
+
+    template<typename F>
+        requires(!std::is_base_of_v<function_base, std::remove_cvref_t<F>>) and accepts<std::decay_t<F>> and
+                std::is_constructible_v<std::decay_t<F>, F&&>
+    function_base(F&& f) noexcept(stored_inline<std::decay_t<F>> and
+                                  std::is_nothrow_constructible_v<std::decay_t<F>, F&&>)
+    {
+        using func_type = std::decay_t<F>;
+        static_assert(HeapFallback or stored_inline<func_type>,
+                      "callable does not fit the inline buffer of a no-heap function");
+
+        // A function reference decays to a pointer but can never be null.
+        if constexpr (std::is_pointer_v<std::remove_cvref_t<F>> or std::is_member_pointer_v<std::remove_cvref_t<F>>)
+        {
+            if (f == nullptr)
+            {
+                return;
+            }
+        }
+
+        if constexpr (stored_inline<func_type>)
+        {
+            ::new (static_cast<void*>(m_storage)) func_type(std::forward<F>(f));
+            m_vtable = &inline_vtable<func_type>;
+        }
+        else
+        {
+            ::new (static_cast<void*>(m_storage)) func_type*(new func_type(std::forward<F>(f)));
+            m_vtable = &heap_vtable<func_type>;
+        }
+    }
+
+    function_base(function_base&& other) noexcept : m_vtable(other.m_vtable)
+    {
+        m_vtable->move(m_storage, other.m_storage);
+        other.m_vtable = &empty_vtable;
+    }
+
+    function_base& operator=(function_base&& other) noexcept
+    {
+        if (this != &other)
+        {
+            m_vtable->destroy(m_storage);
+            m_vtable = other.m_vtable;
+            m_vtable->move(m_storage, other.m_storage);
+            other.m_vtable = &empty_vtable;
+        }
+        return *this;
+    }
+
+    function_base(const function_base&) = delete;
+    function_base& operator=(const function_base&) = delete;
+
+    ~function_base()
+    {
+        m_vtable->destroy(m_storage);
+    }
+
+    R operator()(Args... args) const noexcept(Noexcept)
+    {
+        return m_vtable->invoke(m_storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_vtable != &empty_vtable;
+    }
+
+    void swap(function_base& other) noexcept
+    {
+        function_base tmp{std::move(other)};
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    friend void swap(function_base& a, function_base& b) noexcept
+    {
+        a.swap(b);
+    }
+
+private:
+    struct vtable
+    {
+        R (*invoke)(void*, Args&&...) noexcept(Noexcept);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template<typename F>
+    static F& inline_target(void* storage) noexcept
+    {
+        return *std::launder(static_cast<F*>(storage));
+    }
+
+    template<typename F>
+    static F*& heap_target(void* storage) noexcept
+    {
+        return *std::launder(static_cast<F**>(storage));
+    }
+
+    static R empty_invoke(void*, Args&&...) noexcept(Noexcept)
+    {
+#ifdef HFL_NO_EXCEPTIONS
+        std::terminate();
+#else
+        if constexpr (Noexcept)
+        {
+            std::terminate();
+        }
+        else
+        {
+            throw std::bad_function_call{};
+        }
+#endif
+    }
+
+    static constexpr vtable empty_vtable{
+        &empty_invoke,
+        [](void*, void*) noexcept {},
+        [](void*) noexcept {},
+    };
+
+    template<typename F>
+    static constexpr vtable inline_vtable{
+        [](void* storage, Args&&... args) noexcept(Noexcept) -> R {
+            if constexpr (std::is_void_v<R>)
+            {
+                std::invoke(inline_target<F>(storage), std::forward<Args>(args)...);
+            }
+            else
+            {
+                return std::invoke(inline_target<F>(storage), std::forward<Args>(args)...);
+            }
+        },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) F(std::move(inline_target<F>(src)));
+            inline_target<F>(src).~F();
+        },
+        [](void* storage) noexcept { inline_target<F>(storage).~F(); },
+    };
+
+    template<typename F>
+    static constexpr vtable heap_vtable{
+        [](void* storage, Args&&... args) noexcept(Noexcept) -> R {
+            if constexpr (std::is_void_v<R>)
+            {
+                std::invoke(*heap_target<F>(storage), std::forward<Args>(args)...);
+            }
+            else
+            {
+                return std::invoke(*heap_target<F>(storage), std::forward<Args>(args)...);
+            }
+        },
+        [](void* dst, void* src) noexcept { ::new (dst) F*(heap_target<F>(src)); },
+        [](void* storage) noexcept { delete heap_target<F>(storage); },
+    };
+
+    const vtable* m_vtable{&empty_vtable};
+    alignas(std::max_align_t) mutable unsigned char m_storage[Capacity];
+};
+
+template<typename R, typename... Args, size_t Capacity, bool HeapFallback>
+class basic_function<R(Args...), Capacity, HeapFallback>
+    : public function_base<false, Capacity, HeapFallback, R, Args...>
+{
+public:
+    using function_base<false, Capacity, HeapFallback, R, Args...>::function_base;
+};
+
+template<typename R, typename... Args, size_t Capacity, bool HeapFallback>
+class basic_function<R(Args...) noexcept, Capacity, HeapFallback>
+    : public function_base<true, Capacity, HeapFallback, R, Args...>
+{
+public:
+    using function_base<true, Capacity, HeapFallback, R, Args...>::function_base;
+};
+
+template<typename Sig>
+using function = basic_function<Sig>;
+
+// Never allocates: constructing it from a callable that does not fit fails to
+// compile.
+template<typename Sig, size_t Capacity = function_default_capacity>
+using inplace_function = basic_function<Sig, Capacity, false>;
+
+} // namespace hfl
@@ -0,0 +1,102 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace hfl
+{
+
+// Non-owning reference to a callable: an object pointer plus a thunk, two
+// words that are cheap to pass by value. The referenced callable must outlive
+// the function_ref, which makes it a fit for parameters, not for storage.
+template<typename Sig>
+class function_ref;
+
+template<bool Noexcept, typename R, typename... Args>
+class function_ref_base
+{
+public:
+    template<typename F>
+    static constexpr bool accepts =
+        Noexcept ? std::is_nothrow_invocable_r_v<R, F&, Args...> : std::is_invocable_r_v<R, F&, Args...>;
+
+    template<typename F>
+        requires(!std::is_base_of_v<function_ref_base, std::remove_cvref_t<F>>) and
+                accepts<std::remove_reference_t<F>>
+    function_ref_base(F&& f) noexcept
+    {
+        using target_type = std::remove_reference_t<F>;
+        if constexpr (std::is_function_v<target_type>)
+        {
+            m_target.m_func = reinterpret_cast<void (*)()>(std::addressof(f));
+            m_thunk = [](target_storage target, Args&&... args) noexcept(Noexcept) -> R {
+                if constexpr (std::is_void_v<R>)
+                {
+                    std::invoke(reinterpret_cast<target_type*>(target.m_func), std::forward<Args>(args)...);
+                }
+                else
+                {
+                    return std::invoke(reinterpret_cast<target_type*>(target.m_func), std::forward<Args>(args)...);
+                }
+            };
+        }
+        else
+        {
+            m_target.m_obj = const_cast<void*>(static_cast<const volatile void*>(std::addressof(f)));
+            m_thunk = [](target_storage target, Args&&... args) noexcept(Noexcept) -> R {
+                if constexpr (std::is_void_v<R>)
+                {
+                    std::invoke(*static_cast<target_type*>(target.m_obj), std::forward<Args>(args)...);
+                }
+                else
+                {
+                    return std::invoke(*static_cast<target_type*>(target.m_obj), std::forward<Args>(args)...);
+                }
+            };
+        }
+    }
+
+    R operator()(Args... args) const noexcept(Noexcept)
+    {
+        return m_thunk(m_target, std::forward<Args>(args)...);
+    }
+
+private:
+    union target_storage {
+        void* m_obj;
+        void (*m_func)();
+    };
+
+    target_storage m_target;
+    R (*m_thunk)(target_storage, Args&&...) noexcept(Noexcept);
+};
+
+template<typename R, typename... Args>
+class function_ref<R(Args...)> : public function_ref_base<false, R, Args...>
+{
+public:
+    using function_ref_base<false, R, Args...>::function_ref_base;
+};
+
+template<typename R, typename... Args>
+class function_ref<R(Args...) noexcept> : public function_ref_base<true, R, Args...>
+{
+public:
+    using function_ref_base<true, R, Args...>::function_ref_base;
+};
+
+template<typename T>
+struct is_function_ref : std::false_type
+{
+};
+
+template<typename Sig>
+struct is_function_ref<function_ref<Sig>> : std::true_type
+{
+};
+
+template<typename T>
+constexpr bool is_function_ref_v = is_function_ref<std::remove_cvref_t<T>>::value;
+
+} // namespace hfl
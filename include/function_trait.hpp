@@ -1,6 +1,7 @@
 #pragma once
 #include <functional>
 #include <tuple>
+#include <type_traits>
 
 
 namespace hfl
@@ -14,6 +15,8 @@ struct function_trait<R(Args...)>
 {
     using return_type = R;
 
+    using signature_type = R(Args...);
+
     using args_tuple_type = std::tuple<Args...>;
 
     static constexpr size_t arity = sizeof...(Args);
@@ -43,6 +46,11 @@ struct function_trait<R (*)(Args...)> : public function_trait<R(Args...)>
 {
 };
 
+template<typename R, typename... Args>
+struct function_trait<R (*)(Args...) noexcept> : public function_trait<R(Args...)>
+{
+};
+
 template<typename C, typename R, typename... Args>
 struct function_trait<R (C::*)(Args...)> : public function_trait<R(Args...)>
 {
@@ -53,6 +61,11 @@ struct function_trait<R (C::*)(Args...) const> : public function_trait<R(Args...
 {
 };
 
+template<typename C, typename R, typename... Args>
+struct function_trait<R (C::*)(Args...) const noexcept> : public function_trait<R(Args...)>
+{
+};
+
 template<typename C, typename R, typename... Args>
 struct function_trait<R (C::*)(Args...) const&> : public function_trait<R(Args...)>
 {
@@ -63,4 +76,10 @@ struct function_trait<R (C::*)(Args...) &&> : public function_trait<R(Args...)>
 {
 };
 
-} // namespace hfl
\ No newline at end of file
+// Callables function_trait can describe: functions, function pointers and
+// class types with a single non-template operator().
+template<typename T>
+concept has_function_trait = std::is_function_v<std::remove_pointer_t<std::decay_t<T>>> or
+                             requires { &std::decay_t<T>::operator(); };
+
+} // namespace hfl
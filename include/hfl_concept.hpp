@@ -1,10 +1,11 @@
 #pragma once
 #include <tuple>
+#include <utility>
 
 namespace hfl
 {
 
 template<typename Func, typename TupleArgsType>
-concept callable_with_tuple_args = requires(Func f, TupleArgsType args) { std::apply(f, args); };
+concept callable_with_tuple_args = requires(Func f, TupleArgsType args) { std::apply(f, std::move(args)); };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// Exception-free mode: define HFL_NO_EXCEPTIONS, or build with exceptions
+// disabled. Unwrap failures then go to the handler installed with
+// hfl::set_unwrap_failure_handler and an empty hfl::function terminates.
+#if !defined(HFL_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+#define HFL_NO_EXCEPTIONS
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define HFL_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define HFL_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+// Lets the optimizer take cond as given, for accessors whose caller already
+// checked it. A false cond is undefined behavior.
+#if defined(__clang__)
+#define HFL_ASSUME(cond) __builtin_assume(cond)
+#elif defined(_MSC_VER)
+#define HFL_ASSUME(cond) __assume(cond)
+#elif defined(__GNUC__)
+#define HFL_ASSUME(cond)                                                                                               \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(cond))                                                                                                   \
+            __builtin_unreachable();                                                                                   \
+    } while (false)
+#else
+#define HFL_ASSUME(cond) static_cast<void>(0)
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define HFL_COLD [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+#define HFL_COLD __declspec(noinline)
+#else
+#define HFL_COLD
+#endif
@@ -1,4 +1,5 @@
 #pragma once
+#include "function.hpp"
 #include "optional.hpp"
 #include <functional>
 
@@ -31,6 +32,20 @@ constexpr auto applicative(const optional<T>& res, const optional<std::function<
     }
 }
 
+template<typename T, typename Ret, size_t Capacity, bool HeapFallback>
+constexpr auto applicative(const optional<T>& res, const optional<basic_function<Ret(T), Capacity, HeapFallback>>& f)
+    -> optional<Ret>
+{
+    if (res.has_value() && f.has_value())
+    {
+        return f.value()(res.value());
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
 template<typename T, typename Func>
 constexpr auto mbind(const optional<T>& res, Func&& f) -> decltype(f(std::declval<T>()))
 {
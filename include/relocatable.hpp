@@ -0,0 +1,102 @@
+#pragma once
+#include "rs_common.hpp"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace hfl
+{
+
+// A type is trivially relocatable when moving an object to new storage and
+// destroying the source is the same as copying its bytes and forgetting the
+// source. Trivially copyable types always are, other types opt in:
+//
+//   template<>
+//   struct hfl::is_trivially_relocatable<file_handle> : std::true_type
+//   {
+//   };
+//
+// Only opt in types that hold no pointers into themselves. libstdc++'s
+// std::string, for instance, does not qualify.
+template<typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+{
+};
+
+template<typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+template<typename T>
+struct is_trivially_relocatable<ok<T>>
+    : std::bool_constant<std::is_trivially_copyable_v<ok<T>> or is_trivially_relocatable_v<T>>
+{
+};
+
+template<typename E>
+struct is_trivially_relocatable<err<E>>
+    : std::bool_constant<std::is_trivially_copyable_v<err<E>> or is_trivially_relocatable_v<E>>
+{
+};
+
+template<typename T>
+struct is_trivially_relocatable<some<T>>
+    : std::bool_constant<std::is_trivially_copyable_v<some<T>> or is_trivially_relocatable_v<T>>
+{
+};
+
+// Moves n objects from first into the uninitialized storage at dest and ends
+// the lifetime of the sources, the ranges must not overlap. Trivially
+// relocatable types are copied with a single memcpy. Returns dest + n.
+//
+// If constructing a destination throws, the destinations built so far are
+// destroyed and every source is left alive. Types whose move may throw are
+// copied when they can be, so the sources then also keep their values.
+template<typename T>
+T* uninitialized_relocate_n(T* first, size_t n, T* dest) noexcept(is_trivially_relocatable_v<T> or
+                                                                 std::is_nothrow_move_constructible_v<T>)
+{
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (n != 0)
+        {
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+        }
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<T>)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            std::construct_at(dest + i, std::move(first[i]));
+            std::destroy_at(first + i);
+        }
+    }
+    else
+    {
+        size_t built = 0;
+#ifdef HFL_NO_EXCEPTIONS
+        for (; built < n; ++built)
+        {
+            std::construct_at(dest + built, std::move_if_noexcept(first[built]));
+        }
+#else
+        try
+        {
+            for (; built < n; ++built)
+            {
+                std::construct_at(dest + built, std::move_if_noexcept(first[built]));
+            }
+        }
+        catch (...)
+        {
+            std::destroy_n(dest, built);
+            throw;
+        }
+#endif
+        std::destroy_n(first, n);
+    }
+    return dest + n;
+}
+
+} // namespace hfl
@@ -11,6 +11,8 @@ template<typename T>
 class result
 {
 public:
+    using value_type = T;
+
     result() noexcept = default;
 
     constexpr result(const T& val) noexcept : m_value(val)
@@ -41,7 +43,7 @@ public:
 
     constexpr T value() &&
     {
-        return std::get<T>(m_value);
+        return std::get<T>(std::move(m_value));
     }
 
     constexpr T value_or(T&& right) const noexcept
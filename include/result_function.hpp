@@ -1,4 +1,5 @@
 #pragma once
+#include "function.hpp"
 #include "result.hpp"
 #include <functional>
 
@@ -36,6 +37,25 @@ constexpr auto applicative(const result<T>& res, const result<std::function<Ret(
     }
 }
 
+template<typename T, typename Ret, size_t Capacity, bool HeapFallback>
+constexpr auto applicative(const result<T>& res, const result<basic_function<Ret(T), Capacity, HeapFallback>>& f)
+    -> result<Ret>
+{
+    if (res.has_value() && f.has_value())
+    {
+        return f.value()(res.value());
+    }
+    else
+    {
+        if (!res.has_value())
+        {
+            return result<Ret>(res.error_code());
+        }
+
+        return result<Ret>(f.error_code());
+    }
+}
+
 template<typename T, typename Func>
 constexpr auto mbind(const result<T>& res, Func&& f) -> decltype(f(std::declval<T>()))
 {
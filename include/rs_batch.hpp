@@ -0,0 +1,311 @@
+#pragma once
+#include "rs_result.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hfl
+{
+
+// Struct-of-arrays batch of rs_result<T, E>: ok values live contiguously, a
+// bitmap tells which slots are ok and errors sit in a side table sorted by
+// index. Error slots hold a value-initialized T, so map and filter run their
+// callable over every slot without branching, which lets the compiler
+// vectorize the loop. Those callables must therefore be side-effect free and
+// accept the placeholder value. and_then only visits ok slots.
+template<typename T>
+concept rs_batch_value = std::is_default_constructible_v<T> and !std::is_same_v<std::remove_cv_t<T>, bool>;
+
+template<typename T, typename E>
+    requires std::is_default_constructible_v<T>
+class rs_batch
+{
+    // std::vector<bool> packs its elements and cannot be viewed as a span.
+    static_assert(rs_batch_value<T>, "rs_batch<bool, E> is not supported, store the flags as rs_batch<uint8_t, E>");
+
+public:
+    using value_type = rs_result<T, E>;
+    using error_entry = std::pair<size_t, E>;
+
+    rs_batch() = default;
+
+    template<typename Range>
+        requires std::is_convertible_v<std::ranges::range_reference_t<const Range&>, const value_type&>
+    explicit rs_batch(const Range& results)
+    {
+        if constexpr (std::ranges::sized_range<const Range&>)
+        {
+            reserve(std::ranges::size(results));
+        }
+        for (const value_type& res : results)
+        {
+            push_back(res);
+        }
+    }
+
+    void reserve(size_t n)
+    {
+        m_values.reserve(n);
+        m_valid.reserve(word_count(n));
+    }
+
+    void push_back(const value_type& res)
+    {
+        if (res.is_ok())
+        {
+            push_ok(res.unwrap_unchecked());
+        }
+        else
+        {
+            push_err(res.unwrap_err_unchecked());
+        }
+    }
+
+    void push_back(value_type&& res)
+    {
+        if (res.is_ok())
+        {
+            push_ok(std::move(res).unwrap_unchecked());
+        }
+        else
+        {
+            push_err(std::move(res).unwrap_err_unchecked());
+        }
+    }
+
+    template<typename U>
+    void push_ok(U&& val)
+    {
+        const size_t index = m_values.size();
+        m_values.emplace_back(std::forward<U>(val));
+        grow_bitmap(index);
+        m_valid[index / word_bits] |= uint64_t{1} << (index % word_bits);
+    }
+
+    template<typename U>
+    void push_err(U&& e)
+    {
+        const size_t index = m_values.size();
+        m_values.emplace_back();
+        grow_bitmap(index);
+        m_errors.emplace_back(index, std::forward<U>(e));
+    }
+
+    size_t size() const noexcept
+    {
+        return m_values.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return m_values.empty();
+    }
+
+    size_t err_count() const noexcept
+    {
+        return m_errors.size();
+    }
+
+    size_t ok_count() const noexcept
+    {
+        return size() - err_count();
+    }
+
+    bool is_ok(size_t index) const noexcept
+    {
+        return (m_valid[index / word_bits] >> (index % word_bits)) & 1;
+    }
+
+    bool is_err(size_t index) const noexcept
+    {
+        return !is_ok(index);
+    }
+
+    // Dense values, the slots of errors hold a value-initialized T.
+    std::span<const T> values() const noexcept
+    {
+        return m_values;
+    }
+
+    std::span<const uint64_t> validity() const noexcept
+    {
+        return m_valid;
+    }
+
+    std::span<const error_entry> errors() const noexcept
+    {
+        return m_errors;
+    }
+
+    const E& error(size_t index) const
+    {
+        auto it = find_error(index);
+        if (it == m_errors.end() or it->first != index) [[unlikely]]
+        {
+            unwrap_failed(ok<T>{m_values[index]}, "rs_batch::error called on an ok slot");
+        }
+        return it->second;
+    }
+
+    value_type operator[](size_t index) const
+    {
+        if (is_ok(index))
+        {
+            return value_type{typename value_type::ok_type{m_values[index]}};
+        }
+        return value_type{typename value_type::err_type{find_error(index)->second}};
+    }
+
+    std::vector<value_type> to_results() const
+    {
+        std::vector<value_type> results;
+        results.reserve(size());
+        auto err_it = m_errors.begin();
+        for (size_t i = 0; i < size(); ++i)
+        {
+            if (is_ok(i))
+            {
+                results.emplace_back(typename value_type::ok_type{m_values[i]});
+            }
+            else
+            {
+                results.emplace_back(typename value_type::err_type{(err_it++)->second});
+            }
+        }
+        return results;
+    }
+
+    template<typename Func>
+        requires std::is_invocable_v<Func&, const T&> and
+                 std::is_default_constructible_v<std::remove_cvref_t<std::invoke_result_t<Func&, const T&>>>
+    auto map(Func&& f) const -> rs_batch<std::remove_cvref_t<std::invoke_result_t<Func&, const T&>>, E>
+    {
+        using return_type = rs_batch<std::remove_cvref_t<std::invoke_result_t<Func&, const T&>>, E>;
+        return_type out{};
+        out.m_values.resize(size());
+        const size_t n = size();
+        const T* src = m_values.data();
+        auto* dst = out.m_values.data();
+        for (size_t i = 0; i < n; ++i)
+        {
+            dst[i] = std::invoke(f, src[i]);
+        }
+        out.m_valid = m_valid;
+        out.m_errors = m_errors;
+        return out;
+    }
+
+    template<typename Func>
+        requires std::is_invocable_v<Func&, const T&> and is_rs_result_v<std::invoke_result_t<Func&, const T&>> and
+                 std::is_same_v<typename std::invoke_result_t<Func&, const T&>::raw_err_type, E>
+    auto and_then(Func&& f) const -> rs_batch<typename std::invoke_result_t<Func&, const T&>::raw_ok_type, E>
+    {
+        using return_type = rs_batch<typename std::invoke_result_t<Func&, const T&>::raw_ok_type, E>;
+        return_type out{};
+        out.m_values.resize(size());
+        out.m_valid.assign(m_valid.size(), 0);
+        std::vector<error_entry> new_errors;
+        for (size_t w = 0; w < m_valid.size(); ++w)
+        {
+            for (uint64_t bits = m_valid[w]; bits != 0; bits &= bits - 1)
+            {
+                const size_t index = w * word_bits + static_cast<size_t>(std::countr_zero(bits));
+                auto res = std::invoke(f, m_values[index]);
+                if (res.is_ok()) [[likely]]
+                {
+                    out.m_values[index] = std::move(res).unwrap_unchecked();
+                    out.m_valid[w] |= bits & (~bits + 1);
+                }
+                else
+                {
+                    new_errors.emplace_back(index, std::move(res).unwrap_err_unchecked());
+                }
+            }
+        }
+        out.m_errors = merge_errors(m_errors, std::move(new_errors));
+        return out;
+    }
+
+    // Ok slots failing pred become e.
+    template<typename Pred>
+        requires std::is_invocable_r_v<bool, Pred&, const T&>
+    rs_batch filter(Pred&& pred, const E& e) const
+    {
+        rs_batch out{*this};
+        std::vector<error_entry> new_errors;
+        const size_t n = size();
+        const T* src = m_values.data();
+        for (size_t w = 0; w < m_valid.size(); ++w)
+        {
+            const size_t base = w * word_bits;
+            const size_t count = std::min(word_bits, n - base);
+            uint64_t keep = 0;
+            for (size_t b = 0; b < count; ++b)
+            {
+                keep |= uint64_t{static_cast<bool>(std::invoke(pred, src[base + b]))} << b;
+            }
+            for (uint64_t dropped = m_valid[w] & ~keep; dropped != 0; dropped &= dropped - 1)
+            {
+                new_errors.emplace_back(base + static_cast<size_t>(std::countr_zero(dropped)), e);
+            }
+            out.m_valid[w] &= keep;
+        }
+        out.m_errors = merge_errors(m_errors, std::move(new_errors));
+        return out;
+    }
+
+private:
+    template<typename U, typename F>
+        requires std::is_default_constructible_v<U>
+    friend class rs_batch;
+
+    static constexpr size_t word_bits = 64;
+
+    static constexpr size_t word_count(size_t n) noexcept
+    {
+        return (n + word_bits - 1) / word_bits;
+    }
+
+    void grow_bitmap(size_t index)
+    {
+        if (index % word_bits == 0)
+        {
+            m_valid.push_back(0);
+        }
+    }
+
+    auto find_error(size_t index) const
+    {
+        return std::lower_bound(m_errors.begin(), m_errors.end(), index,
+                                [](const error_entry& entry, size_t i) { return entry.first < i; });
+    }
+
+    static std::vector<error_entry> merge_errors(const std::vector<error_entry>& old_errors,
+                                                 std::vector<error_entry>&& new_errors)
+    {
+        if (new_errors.empty())
+        {
+            return old_errors;
+        }
+        std::vector<error_entry> merged;
+        merged.reserve(old_errors.size() + new_errors.size());
+        std::merge(old_errors.begin(), old_errors.end(), std::make_move_iterator(new_errors.begin()),
+                   std::make_move_iterator(new_errors.end()), std::back_inserter(merged),
+                   [](const error_entry& a, const error_entry& b) { return a.first < b.first; });
+        return merged;
+    }
+
+    std::vector<T> m_values;
+    std::vector<uint64_t> m_valid;
+    std::vector<error_entry> m_errors;
+};
+
+} // namespace hfl
@@ -1,16 +1,20 @@
 #pragma once
+#include "hfl_config.hpp"
+#include <atomic>
+#include <cstdlib>
 #include <exception>
 #include <functional>
 #include <string>
 #include <type_traits>
 #include <variant>
+
 namespace hfl
 {
 
 template<typename T>
 struct ok
 {
-    T m_value;
+    HFL_NO_UNIQUE_ADDRESS T m_value;
 };
 
 template<typename T>
@@ -19,7 +23,7 @@ ok(T) -> ok<T>;
 template<typename E>
 struct err
 {
-    E m_value;
+    HFL_NO_UNIQUE_ADDRESS E m_value;
 };
 
 template<typename E>
@@ -29,7 +33,7 @@ err(E) -> err<E>;
 template<typename T>
 struct some
 {
-    T m_value;
+    HFL_NO_UNIQUE_ADDRESS T m_value;
 };
 
 template<typename T>
@@ -39,46 +43,131 @@ struct none
 {
 };
 
+// The unwrap exceptions carry the failing call's message, expect(msg) puts the
+// caller's msg there.
 template<typename E>
 struct unwrap_exception : public std::exception
 {
-    unwrap_exception(const err<E>& e) : m_e(e)
+    unwrap_exception(const err<E>& e, std::string message = "unwrap_exception") : m_e(e), m_message(std::move(message))
     {
     }
     const char* what() const noexcept override
     {
-        return "unwrap_exception";
+        return m_message.c_str();
     }
     err<E> m_e;
+    std::string m_message;
 };
 
 
 struct unwrap_none_exception : public std::exception
 {
-    unwrap_none_exception()
+    unwrap_none_exception(std::string message = "unwrap_none_exception") : m_message(std::move(message))
     {
     }
 
     const char* what() const noexcept override
     {
-        return "unwrap_none_exception";
+        return m_message.c_str();
     }
+
+    std::string m_message;
 };
 
 
 template<typename T>
 struct unwrap_err_exception : public std::exception
 {
-    unwrap_err_exception(const ok<T>& v) : m_v(v)
+    unwrap_err_exception(const ok<T>& v, std::string message = "unwrap_err_exception")
+        : m_v(v), m_message(std::move(message))
     {
     }
 
     const char* what() const noexcept override
     {
-        return "unwrap_err_exception";
+        return m_message.c_str();
     }
 
     ok<T> m_v;
+    std::string m_message;
+};
+
+enum class unwrap_failure_kind
+{
+    unwrap_on_err,
+    unwrap_err_on_ok,
+    unwrap_on_none,
+};
+
+// Called instead of throwing when exceptions are off. The handler must not
+// return, if it does (or none is installed) the process aborts.
+using unwrap_failure_handler = void (*)(unwrap_failure_kind kind, const char* message) noexcept;
+
+inline std::atomic<unwrap_failure_handler>& unwrap_failure_handler_slot() noexcept
+{
+    static std::atomic<unwrap_failure_handler> handler{nullptr};
+    return handler;
+}
+
+// Returns the previously installed handler.
+inline unwrap_failure_handler set_unwrap_failure_handler(unwrap_failure_handler handler) noexcept
+{
+    return unwrap_failure_handler_slot().exchange(handler, std::memory_order_acq_rel);
+}
+
+[[noreturn]] HFL_COLD inline void report_unwrap_failure(unwrap_failure_kind kind, const char* message) noexcept
+{
+    if (auto handler = unwrap_failure_handler_slot().load(std::memory_order_acquire))
+    {
+        handler(kind, message);
+    }
+    std::abort();
+}
+
+// Failure paths of unwrap and friends, kept out of line so the callers' hot
+// path is only the test and a call. Without exceptions nothing is copied.
+template<typename E>
+[[noreturn]] HFL_COLD void unwrap_failed([[maybe_unused]] const err<E>& e,
+                                         const char* message = "unwrap called on an err")
+{
+#ifdef HFL_NO_EXCEPTIONS
+    report_unwrap_failure(unwrap_failure_kind::unwrap_on_err, message);
+#else
+    throw unwrap_exception<E>{e, message};
+#endif
+}
+
+template<typename T>
+[[noreturn]] HFL_COLD void unwrap_failed([[maybe_unused]] const ok<T>& v,
+                                         const char* message = "unwrap_err called on an ok")
+{
+#ifdef HFL_NO_EXCEPTIONS
+    report_unwrap_failure(unwrap_failure_kind::unwrap_err_on_ok, message);
+#else
+    throw unwrap_err_exception<T>{v, message};
+#endif
+}
+
+[[noreturn]] HFL_COLD inline void unwrap_failed(none, const char* message = "unwrap called on a none")
+{
+#ifdef HFL_NO_EXCEPTIONS
+    report_unwrap_failure(unwrap_failure_kind::unwrap_on_none, message);
+#else
+    throw unwrap_none_exception{message};
+#endif
+}
+
+// Converts to T by calling its function, so T is built right where the
+// converted value goes instead of being moved there.
+template<typename T, typename Func>
+struct deferred_value
+{
+    constexpr operator T() &&
+    {
+        return std::invoke(std::forward<Func>(m_func));
+    }
+
+    Func m_func;
 };
 
 template<typename T, typename E>
@@ -0,0 +1,247 @@
+#pragma once
+#include "result.hpp"
+#include "rs_option.hpp"
+#include "rs_result.hpp"
+#include <optional>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <version>
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+#include <expected>
+#define HFL_HAS_EXPECTED
+#endif
+
+// Explicit conversions between rs_result, rs_option, result, std::optional
+// and std::expected. Every conversion takes its source by forwarding
+// reference: an rvalue source is moved from, and its payload is moved once,
+// straight into the new object; an lvalue source is copied once.
+//
+//   auto port = hfl::ok_or(lookup(env, "PORT"), config_error::missing_port);
+//   hfl::rs_option<int> timeout = hfl::to_option(parse_int(raw));
+
+namespace hfl
+{
+
+template<typename T>
+struct is_std_optional : std::false_type
+{
+};
+
+template<typename T>
+struct is_std_optional<std::optional<T>> : std::true_type
+{
+};
+
+template<typename T>
+constexpr bool is_std_optional_v = is_std_optional<T>::value;
+
+template<typename T>
+struct is_hfl_result : std::false_type
+{
+};
+
+template<typename T>
+struct is_hfl_result<result<T>> : std::true_type
+{
+};
+
+template<typename X>
+concept rs_option_ref = is_rs_option_v<std::remove_cvref_t<X>>;
+
+template<typename X>
+concept rs_result_ref = is_rs_result_v<std::remove_cvref_t<X>>;
+
+template<typename X>
+concept std_optional_ref = is_std_optional_v<std::remove_cvref_t<X>>;
+
+template<typename X>
+concept hfl_result_ref = is_hfl_result<std::remove_cvref_t<X>>::value;
+
+template<typename Option>
+    requires rs_option_ref<Option>
+constexpr auto to_optional(Option&& o) -> std::optional<typename std::remove_cvref_t<Option>::raw_some_type>
+{
+    if (o.is_some())
+    {
+        return std::optional<typename std::remove_cvref_t<Option>::raw_some_type>{
+            std::in_place, std::forward<Option>(o).unwrap_unchecked()};
+    }
+    return std::nullopt;
+}
+
+// The error is dropped.
+template<typename Result>
+    requires rs_result_ref<Result>
+constexpr auto to_optional(Result&& r) -> std::optional<typename std::remove_cvref_t<Result>::raw_ok_type>
+{
+    if (r.is_ok())
+    {
+        return std::optional<typename std::remove_cvref_t<Result>::raw_ok_type>{
+            std::in_place, std::forward<Result>(r).unwrap_unchecked()};
+    }
+    return std::nullopt;
+}
+
+template<typename Optional>
+    requires std_optional_ref<Optional>
+constexpr auto to_option(Optional&& o) -> rs_option<typename std::remove_cvref_t<Optional>::value_type>
+{
+    using return_type = rs_option<typename std::remove_cvref_t<Optional>::value_type>;
+    if (o.has_value())
+    {
+        return return_type{*std::forward<Optional>(o)};
+    }
+    return return_type{none{}};
+}
+
+// The error is dropped.
+template<typename Result>
+    requires rs_result_ref<Result>
+constexpr auto to_option(Result&& r) -> rs_option<typename std::remove_cvref_t<Result>::raw_ok_type>
+{
+    using return_type = rs_option<typename std::remove_cvref_t<Result>::raw_ok_type>;
+    if (r.is_ok())
+    {
+        return return_type{std::forward<Result>(r).unwrap_unchecked()};
+    }
+    return return_type{none{}};
+}
+
+// rs_option has ok_or as a member, this is the std::optional one.
+template<typename Optional, typename E>
+    requires std_optional_ref<Optional>
+constexpr auto ok_or(Optional&& o, E&& e)
+    -> rs_result<typename std::remove_cvref_t<Optional>::value_type, std::decay_t<E>>
+{
+    using value_type = typename std::remove_cvref_t<Optional>::value_type;
+    using return_type = rs_result<value_type, std::decay_t<E>>;
+    if (o.has_value())
+    {
+        return return_type{std::in_place_type<ok<value_type>>, *std::forward<Optional>(o)};
+    }
+    return return_type{std::in_place_type<err<std::decay_t<E>>>, std::forward<E>(e)};
+}
+
+// rs_option<rs_result<T, E>> to rs_result<rs_option<T>, E>: none becomes
+// ok(none), some(ok(v)) becomes ok(some(v)) and some(err(e)) becomes err(e).
+template<typename Option>
+    requires rs_option_ref<Option> and is_rs_result_v<typename std::remove_cvref_t<Option>::raw_some_type>
+constexpr auto transpose(Option&& o)
+{
+    using inner_type = typename std::remove_cvref_t<Option>::raw_some_type;
+    using option_type = rs_option<typename inner_type::raw_ok_type>;
+    using return_type = rs_result<option_type, typename inner_type::raw_err_type>;
+    if (o.is_none())
+    {
+        return return_type{std::in_place_type<ok<option_type>>, option_type{none{}}};
+    }
+    if (o.unwrap_unchecked().is_err())
+    {
+        return return_type{std::in_place_type<typename return_type::err_type>,
+                           std::forward<Option>(o).unwrap_unchecked().unwrap_err_unchecked()};
+    }
+    auto build = [&]() { return option_type{std::forward<Option>(o).unwrap_unchecked().unwrap_unchecked()}; };
+    return return_type{std::in_place_type<ok<option_type>>, deferred_value<option_type, decltype(build)&>{build}};
+}
+
+// rs_result<rs_option<T>, E> to rs_option<rs_result<T, E>>, the inverse of
+// the overload above.
+template<typename Result>
+    requires rs_result_ref<Result> and is_rs_option_v<typename std::remove_cvref_t<Result>::raw_ok_type>
+constexpr auto transpose(Result&& r)
+{
+    using inner_type = typename std::remove_cvref_t<Result>::raw_ok_type;
+    using result_type =
+        rs_result<typename inner_type::raw_some_type, typename std::remove_cvref_t<Result>::raw_err_type>;
+    using return_type = rs_option<result_type>;
+    if (r.is_ok() and r.unwrap_unchecked().is_none())
+    {
+        return return_type{none{}};
+    }
+    auto build = [&]() {
+        if (r.is_ok())
+        {
+            return result_type{std::in_place_type<typename result_type::ok_type>,
+                               std::forward<Result>(r).unwrap_unchecked().unwrap_unchecked()};
+        }
+        return result_type{std::in_place_type<typename result_type::err_type>,
+                           std::forward<Result>(r).unwrap_err_unchecked()};
+    };
+    return return_type{deferred_value<result_type, decltype(build)&>{build}};
+}
+
+template<typename Result>
+    requires hfl_result_ref<Result>
+auto from_error_code(Result&& r) -> rs_result<typename std::remove_cvref_t<Result>::value_type, std::error_code>
+{
+    using value_type = typename std::remove_cvref_t<Result>::value_type;
+    using return_type = rs_result<value_type, std::error_code>;
+    if (r.has_value())
+    {
+        auto build = [&]() -> value_type { return std::forward<Result>(r).value(); };
+        return return_type{std::in_place_type<ok<value_type>>, deferred_value<value_type, decltype(build)&>{build}};
+    }
+    return return_type{std::in_place_type<err<std::error_code>>, r.error_code()};
+}
+
+template<typename Result>
+    requires rs_result_ref<Result> and
+             std::is_same_v<typename std::remove_cvref_t<Result>::raw_err_type, std::error_code>
+auto to_result(Result&& r) -> result<typename std::remove_cvref_t<Result>::raw_ok_type>
+{
+    using return_type = result<typename std::remove_cvref_t<Result>::raw_ok_type>;
+    if (r.is_ok())
+    {
+        return return_type{std::forward<Result>(r).unwrap_unchecked()};
+    }
+    return return_type{std::forward<Result>(r).unwrap_err_unchecked()};
+}
+
+#ifdef HFL_HAS_EXPECTED
+
+template<typename T>
+struct is_std_expected : std::false_type
+{
+};
+
+template<typename T, typename E>
+struct is_std_expected<std::expected<T, E>> : std::true_type
+{
+};
+
+template<typename X>
+concept std_expected_ref = is_std_expected<std::remove_cvref_t<X>>::value;
+
+template<typename Result>
+    requires rs_result_ref<Result>
+constexpr auto to_expected(Result&& r) -> std::expected<typename std::remove_cvref_t<Result>::raw_ok_type,
+                                                        typename std::remove_cvref_t<Result>::raw_err_type>
+{
+    using return_type = std::expected<typename std::remove_cvref_t<Result>::raw_ok_type,
+                                      typename std::remove_cvref_t<Result>::raw_err_type>;
+    if (r.is_ok())
+    {
+        return return_type{std::in_place, std::forward<Result>(r).unwrap_unchecked()};
+    }
+    return return_type{std::unexpect, std::forward<Result>(r).unwrap_err_unchecked()};
+}
+
+template<typename Expected>
+    requires std_expected_ref<Expected>
+constexpr auto from_expected(Expected&& x) -> rs_result<typename std::remove_cvref_t<Expected>::value_type,
+                                                        typename std::remove_cvref_t<Expected>::error_type>
+{
+    using value_type = typename std::remove_cvref_t<Expected>::value_type;
+    using error_type = typename std::remove_cvref_t<Expected>::error_type;
+    using return_type = rs_result<value_type, error_type>;
+    if (x.has_value())
+    {
+        return return_type{std::in_place_type<ok<value_type>>, *std::forward<Expected>(x)};
+    }
+    return return_type{std::in_place_type<err<error_type>>, std::forward<Expected>(x).error()};
+}
+
+#endif
+
+} // namespace hfl
@@ -0,0 +1,320 @@
+#pragma once
+#include "rs_option.hpp"
+#include "rs_result.hpp"
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Makes rs_result and rs_option coroutine return types. Inside such a
+// coroutine co_await r gives the payload of r, or returns r's error (or none)
+// from the coroutine right away, like ? in Rust:
+//
+//   hfl::rs_result<int, std::string> sum(std::string_view a, std::string_view b)
+//   {
+//       int x = co_await parse(a);
+//       int y = co_await parse(b);
+//       co_return x + y;
+//   }
+//
+// The coroutines never stay suspended, so their frames are created and
+// destroyed in LIFO order and come from a per-thread stack buffer instead of
+// the heap. A frame that does not fit falls back to operator new.
+//
+// The result is read when the object returned by get_return_object is
+// converted to the coroutine's rs_result or rs_option, so that conversion has
+// to happen after the body has run. GCC and Clang 16 and later do it then,
+// MSVC and older Clang convert right away and are rejected below.
+
+#if defined(__clang__)
+#if defined(__apple_build_version__) ? __clang_major__ < 15 : __clang_major__ < 16
+#error "rs_coroutine.hpp needs Clang 16 or later, older versions convert the return object before the body runs"
+#endif
+#elif defined(_MSC_VER)
+#error "rs_coroutine.hpp does not support MSVC, it converts the return object before the body runs"
+#endif
+
+#ifndef HFL_COROUTINE_FRAME_STACK_SIZE
+#define HFL_COROUTINE_FRAME_STACK_SIZE (64 * 1024)
+#endif
+
+namespace hfl
+{
+
+class coroutine_frame_stack
+{
+public:
+    static void* allocate(size_t size)
+    {
+        auto& stack = instance();
+        const size_t rounded = round_up(size);
+        if (rounded <= capacity - stack.m_top) [[likely]]
+        {
+            void* p = stack.m_buffer + stack.m_top;
+            stack.m_top += rounded;
+            return p;
+        }
+        return ::operator new(size);
+    }
+
+    static void deallocate(void* p, size_t size) noexcept
+    {
+        auto& stack = instance();
+        auto* bytes = static_cast<unsigned char*>(p);
+        if (bytes >= stack.m_buffer and bytes < stack.m_buffer + capacity) [[likely]]
+        {
+            stack.m_top = static_cast<size_t>(bytes - stack.m_buffer);
+            return;
+        }
+        ::operator delete(p, size);
+    }
+
+    // Bytes of the calling thread's buffer held by live frames.
+    static size_t used() noexcept
+    {
+        return instance().m_top;
+    }
+
+private:
+    static constexpr size_t capacity = HFL_COROUTINE_FRAME_STACK_SIZE;
+
+    static constexpr size_t round_up(size_t size) noexcept
+    {
+        constexpr size_t align = alignof(std::max_align_t);
+        return (size + align - 1) / align * align;
+    }
+
+    static coroutine_frame_stack& instance() noexcept
+    {
+        thread_local coroutine_frame_stack stack;
+        return stack;
+    }
+
+    alignas(std::max_align_t) unsigned char m_buffer[capacity];
+    size_t m_top{0};
+};
+
+// Where a running coroutine leaves its result. It lives in the return object,
+// outside the frame, and is read when the caller converts the return object
+// to the declared return type, after the coroutine has finished.
+template<typename Value>
+struct coroutine_result_slot
+{
+    std::optional<Value> m_value;
+
+    bool finished() const noexcept
+    {
+        return m_value.has_value();
+    }
+};
+
+template<typename Value>
+class coroutine_promise_base;
+
+template<typename Value>
+class coroutine_return_object
+{
+public:
+    explicit coroutine_return_object(coroutine_promise_base<Value>& promise) noexcept : m_promise(&promise)
+    {
+        m_promise->m_slot = &m_slot;
+    }
+
+    coroutine_return_object(coroutine_return_object&& other) noexcept
+        : m_promise(other.m_promise), m_slot(std::move(other.m_slot))
+    {
+        if (!m_slot.finished())
+        {
+            m_promise->m_slot = &m_slot;
+        }
+    }
+
+    coroutine_return_object(const coroutine_return_object&) = delete;
+    coroutine_return_object& operator=(const coroutine_return_object&) = delete;
+    coroutine_return_object& operator=(coroutine_return_object&&) = delete;
+
+    // The frame is gone by now, and GCC frees it a second time when an
+    // exception leaves the conversion, so it must not throw.
+    operator Value() && noexcept
+    {
+        return std::move(*m_slot.m_value);
+    }
+
+private:
+    coroutine_promise_base<Value>* m_promise;
+    coroutine_result_slot<Value> m_slot;
+};
+
+template<typename Value>
+class coroutine_promise_base
+{
+public:
+    static void* operator new(size_t size)
+    {
+        return coroutine_frame_stack::allocate(size);
+    }
+
+    static void operator delete(void* p, size_t size) noexcept
+    {
+        coroutine_frame_stack::deallocate(p, size);
+    }
+
+    coroutine_return_object<Value> get_return_object() noexcept
+    {
+        return coroutine_return_object<Value>{*this};
+    }
+
+    std::suspend_never initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    std::suspend_never final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    template<typename U>
+        requires std::is_constructible_v<Value, U&&>
+    void return_value(U&& val) noexcept(std::is_nothrow_constructible_v<Value, U&&>)
+    {
+        m_slot->m_value.emplace(std::forward<U>(val));
+    }
+
+    // Rethrown while the frame is still alive, the exception then leaves the
+    // coroutine call itself and the frame is freed on the way out.
+    [[noreturn]] void unhandled_exception()
+    {
+#ifndef HFL_NO_EXCEPTIONS
+        throw;
+#else
+        std::terminate();
+#endif
+    }
+
+protected:
+    template<typename... Us>
+    void fail(Us&&... us)
+    {
+        m_slot->m_value.emplace(std::forward<Us>(us)...);
+    }
+
+private:
+    friend class coroutine_return_object<Value>;
+
+    coroutine_result_slot<Value>* m_slot{nullptr};
+};
+
+// co_await on a failed operand stores the failure and destroys the frame, so
+// the coroutine returns to its caller without being resumed.
+template<typename T, typename E>
+class rs_result_promise : public coroutine_promise_base<rs_result<T, E>>
+{
+public:
+    template<typename U, typename F>
+        requires std::is_constructible_v<E, const F&>
+    auto await_transform(const rs_result<U, F>& res) noexcept
+    {
+        return result_awaiter<const rs_result<U, F>&, const typename rs_result<U, F>::raw_ok_type&>{res};
+    }
+
+    template<typename U, typename F>
+        requires std::is_constructible_v<E, F&&>
+    auto await_transform(rs_result<U, F>&& res) noexcept
+    {
+        return result_awaiter<rs_result<U, F>&&, typename rs_result<U, F>::raw_ok_type>{std::move(res)};
+    }
+
+private:
+    template<typename Operand, typename Payload>
+    class result_awaiter
+    {
+    public:
+        explicit result_awaiter(Operand res) noexcept : m_res(std::forward<Operand>(res))
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return m_res.is_ok();
+        }
+
+        void await_suspend(std::coroutine_handle<rs_result_promise> handle)
+        {
+            using err_type = typename rs_result<T, E>::err_type;
+            handle.promise().fail(err_type{std::forward<Operand>(m_res).unwrap_err_unchecked()});
+            handle.destroy();
+        }
+
+        Payload await_resume()
+        {
+            return std::forward<Operand>(m_res).unwrap_unchecked();
+        }
+
+    private:
+        Operand m_res;
+    };
+};
+
+template<typename T>
+class rs_option_promise : public coroutine_promise_base<rs_option<T>>
+{
+public:
+    template<typename U>
+    auto await_transform(const rs_option<U>& opt) noexcept
+    {
+        return option_awaiter<const rs_option<U>&, const U&>{opt};
+    }
+
+    template<typename U>
+    auto await_transform(rs_option<U>&& opt) noexcept
+    {
+        return option_awaiter<rs_option<U>&&, U>{std::move(opt)};
+    }
+
+private:
+    template<typename Operand, typename Payload>
+    class option_awaiter
+    {
+    public:
+        explicit option_awaiter(Operand opt) noexcept : m_opt(std::forward<Operand>(opt))
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return m_opt.is_some();
+        }
+
+        void await_suspend(std::coroutine_handle<rs_option_promise> handle)
+        {
+            handle.promise().fail(none{});
+            handle.destroy();
+        }
+
+        Payload await_resume()
+        {
+            return std::forward<Operand>(m_opt).unwrap_unchecked();
+        }
+
+    private:
+        Operand m_opt;
+    };
+};
+
+} // namespace hfl
+
+template<typename T, typename E, typename... Args>
+struct std::coroutine_traits<hfl::rs_result<T, E>, Args...>
+{
+    using promise_type = hfl::rs_result_promise<T, E>;
+};
+
+template<typename T, typename... Args>
+struct std::coroutine_traits<hfl::rs_option<T>, Args...>
+{
+    using promise_type = hfl::rs_option_promise<T>;
+};
@@ -1,9 +1,13 @@
 #pragma once
+#include "relocatable.hpp"
 #include "rs_common.hpp"
+#include "rs_result.hpp"
+#include "rs_storage.hpp"
 #include <exception>
 #include <functional>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace hfl
@@ -31,51 +35,100 @@ public:
     using raw_some_type = T;
 
     template<typename U>
+        requires(!std::is_same_v<std::remove_cvref_t<U>, rs_option> and
+                 !std::is_same_v<std::remove_cvref_t<U>, some_type> and
+                 !std::is_same_v<std::remove_cvref_t<U>, none> and std::is_constructible_v<some_type, U &&>)
     constexpr explicit rs_option(U&& val) noexcept(std::is_nothrow_constructible_v<some_type, U&&>)
         : m_value(std::in_place_type<some_type>, std::forward<U>(val))
     {
     }
 
-    constexpr explicit rs_option(const some_type& val) noexcept : m_value(val)
+    constexpr explicit rs_option(const some_type& val) noexcept : m_value(std::in_place_type<some_type>, val)
     {
     }
 
-    constexpr explicit rs_option(some_type&& val) noexcept : m_value(std::move(val))
+    constexpr explicit rs_option(some_type&& val) noexcept : m_value(std::in_place_type<some_type>, std::move(val))
     {
     }
 
-    constexpr explicit rs_option(none val) noexcept : m_value(val)
+    constexpr explicit rs_option(none val) noexcept : m_value(std::in_place_type<none>, val)
     {
     }
 
     constexpr bool is_some() const noexcept
     {
-        return std::holds_alternative<some_type>(m_value);
+        return m_value.template holds<some_type>();
     }
 
     constexpr bool is_none() const noexcept
     {
-        return std::holds_alternative<none>(m_value);
+        return m_value.template holds<none>();
     }
 
     constexpr std::remove_cvref_t<T> unwrap() const
     {
         if (is_none()) [[unlikely]]
         {
-            throw unwrap_none_exception{};
+            unwrap_failed(none{});
         }
 
-        return std::get<some_type>(m_value).m_value;
+        return m_value.template get<some_type>().m_value;
     }
 
     constexpr T unwrap()
     {
         if (is_none()) [[unlikely]]
         {
-            throw unwrap_none_exception{};
+            unwrap_failed(none{});
         }
 
-        return std::get<some_type>(m_value).m_value;
+        return m_value.template get<some_type>().m_value;
+    }
+
+    constexpr const raw_some_type& unwrap_ref() const&
+    {
+        if (is_none()) [[unlikely]]
+        {
+            unwrap_failed(none{});
+        }
+        return m_value.template get<some_type>().m_value;
+    }
+
+    constexpr std::add_lvalue_reference_t<T> unwrap_ref() &
+    {
+        if (is_none()) [[unlikely]]
+        {
+            unwrap_failed(none{});
+        }
+        return m_value.template get<some_type>().m_value;
+    }
+
+    constexpr std::add_rvalue_reference_t<T> unwrap_ref() &&
+    {
+        if (is_none()) [[unlikely]]
+        {
+            unwrap_failed(none{});
+        }
+        return std::move(m_value.template get<some_type>()).m_value;
+    }
+
+    // For code that already tested is_some(), undefined behavior on none.
+    constexpr const raw_some_type& unwrap_unchecked() const& noexcept
+    {
+        HFL_ASSUME(is_some());
+        return m_value.template get<some_type>().m_value;
+    }
+
+    constexpr std::add_lvalue_reference_t<T> unwrap_unchecked() & noexcept
+    {
+        HFL_ASSUME(is_some());
+        return m_value.template get<some_type>().m_value;
+    }
+
+    constexpr std::add_rvalue_reference_t<T> unwrap_unchecked() && noexcept
+    {
+        HFL_ASSUME(is_some());
+        return std::move(m_value.template get<some_type>()).m_value;
     }
 
     template<typename U>
@@ -87,18 +140,50 @@ public:
             return val;
         }
 
-        return std::get<some_type>(m_value).m_value;
+        return m_value.template get<some_type>().m_value;
     }
 
+    // err_func is called without arguments.
     template<typename OkFunc, typename ErrFunc>
         requires std::is_invocable_v<OkFunc, some_type&> and std::is_invocable_v<ErrFunc>
     constexpr decltype(auto) match(OkFunc&& val_func,
                                    ErrFunc&& err_func) & noexcept(std::is_nothrow_invocable_v<OkFunc, some_type&> and
                                                                   std::is_nothrow_invocable_v<ErrFunc>)
     {
-        if (is_none()) [[likely]]
+        if (is_some()) [[likely]]
+        {
+            return std::invoke(std::forward<OkFunc>(val_func), m_value.template get<some_type>());
+        }
+        else
+        {
+            return std::invoke(std::forward<ErrFunc>(err_func));
+        }
+    }
+
+    template<typename OkFunc, typename ErrFunc>
+        requires std::is_invocable_v<OkFunc, const some_type&> and std::is_invocable_v<ErrFunc>
+    constexpr decltype(auto) match(OkFunc&& val_func, ErrFunc&& err_func) const& noexcept(
+        std::is_nothrow_invocable_v<OkFunc, const some_type&> and std::is_nothrow_invocable_v<ErrFunc>)
+    {
+        if (is_some()) [[likely]]
+        {
+            return std::invoke(std::forward<OkFunc>(val_func), m_value.template get<some_type>());
+        }
+        else
+        {
+            return std::invoke(std::forward<ErrFunc>(err_func));
+        }
+    }
+
+    template<typename OkFunc, typename ErrFunc>
+        requires std::is_invocable_v<OkFunc, some_type&&> and std::is_invocable_v<ErrFunc>
+    constexpr decltype(auto) match(OkFunc&& val_func,
+                                   ErrFunc&& err_func) && noexcept(std::is_nothrow_invocable_v<OkFunc, some_type&&> and
+                                                                   std::is_nothrow_invocable_v<ErrFunc>)
+    {
+        if (is_some()) [[likely]]
         {
-            return std::invoke(std::forward<OkFunc>(val_func), std::get<some_type>(m_value));
+            return std::invoke(std::forward<OkFunc>(val_func), std::move(m_value.template get<some_type>()));
         }
         else
         {
@@ -106,17 +191,205 @@ public:
         }
     }
 
+    template<typename Func>
+        requires std::is_invocable_v<Func, const raw_some_type&>
+    constexpr auto map(Func&& f) const& noexcept(std::is_nothrow_invocable_v<Func, const raw_some_type&>)
+        -> rs_option<std::invoke_result_t<Func, const raw_some_type&>>
+    {
+        using return_type = std::invoke_result_t<Func, const raw_some_type&>;
+        if (is_some()) [[likely]]
+        {
+            return rs_option<return_type>{
+                some<return_type>{std::invoke(std::forward<Func>(f), inter_unwrap_some().m_value)}};
+        }
+        return rs_option<return_type>{none{}};
+    }
+
+    template<typename Func>
+        requires std::is_invocable_v<Func, T&&>
+    constexpr auto map(Func&& f) && noexcept(std::is_nothrow_invocable_v<Func, T&&>)
+        -> rs_option<std::invoke_result_t<Func, T&&>>
+    {
+        using return_type = std::invoke_result_t<Func, T&&>;
+        if (is_some()) [[likely]]
+        {
+            return rs_option<return_type>{
+                some<return_type>{std::invoke(std::forward<Func>(f), std::move(*this).unwrap_unchecked())}};
+        }
+        return rs_option<return_type>{none{}};
+    }
+
+    template<typename Func>
+        requires std::is_invocable_v<Func, const raw_some_type&> and
+                 is_rs_option_v<std::invoke_result_t<Func, const raw_some_type&>>
+    constexpr auto and_then(Func&& f) const& noexcept(std::is_nothrow_invocable_v<Func, const raw_some_type&>)
+        -> std::invoke_result_t<Func, const raw_some_type&>
+    {
+        using return_type = std::invoke_result_t<Func, const raw_some_type&>;
+        if (is_some()) [[likely]]
+        {
+            return std::invoke(std::forward<Func>(f), inter_unwrap_some().m_value);
+        }
+        return return_type{none{}};
+    }
+
+    template<typename Func>
+        requires std::is_invocable_v<Func, T&&> and is_rs_option_v<std::invoke_result_t<Func, T&&>>
+    constexpr auto and_then(Func&& f) && noexcept(std::is_nothrow_invocable_v<Func, T&&>)
+        -> std::invoke_result_t<Func, T&&>
+    {
+        using return_type = std::invoke_result_t<Func, T&&>;
+        if (is_some()) [[likely]]
+        {
+            return std::invoke(std::forward<Func>(f), std::move(*this).unwrap_unchecked());
+        }
+        return return_type{none{}};
+    }
+
+    template<typename Func>
+        requires std::is_invocable_r_v<rs_option, Func>
+    constexpr rs_option or_else(Func&& f) const& noexcept(std::is_nothrow_invocable_r_v<rs_option, Func> and
+                                                          std::is_nothrow_copy_constructible_v<some_type>)
+    {
+        if (is_some()) [[likely]]
+        {
+            return *this;
+        }
+        return std::invoke(std::forward<Func>(f));
+    }
+
+    template<typename Func>
+        requires std::is_invocable_r_v<rs_option, Func>
+    constexpr rs_option or_else(Func&& f) && noexcept(std::is_nothrow_invocable_r_v<rs_option, Func> and
+                                                      std::is_nothrow_move_constructible_v<some_type>)
+    {
+        if (is_some()) [[likely]]
+        {
+            return std::move(*this);
+        }
+        return std::invoke(std::forward<Func>(f));
+    }
+
+    template<typename Pred>
+        requires std::is_invocable_r_v<bool, Pred, const raw_some_type&>
+    constexpr rs_option filter(Pred&& pred) const& noexcept(
+        std::is_nothrow_invocable_r_v<bool, Pred, const raw_some_type&> and
+        std::is_nothrow_copy_constructible_v<some_type>)
+    {
+        if (is_some() and std::invoke(std::forward<Pred>(pred), inter_unwrap_some().m_value))
+        {
+            return *this;
+        }
+        return rs_option{none{}};
+    }
+
+    template<typename Pred>
+        requires std::is_invocable_r_v<bool, Pred, const raw_some_type&>
+    constexpr rs_option filter(Pred&& pred) && noexcept(
+        std::is_nothrow_invocable_r_v<bool, Pred, const raw_some_type&> and
+        std::is_nothrow_move_constructible_v<some_type>)
+    {
+        if (is_some() and std::invoke(std::forward<Pred>(pred), inter_unwrap_some().m_value))
+        {
+            return std::move(*this);
+        }
+        return rs_option{none{}};
+    }
+
+    // Moves the payload out and leaves none behind.
+    constexpr rs_option take() & noexcept(std::is_nothrow_move_constructible_v<some_type>)
+    {
+        rs_option taken{std::move(*this)};
+        m_value.template emplace<none>();
+        return taken;
+    }
+
+    // Stores val and returns what was there before.
+    template<typename U>
+        requires std::is_constructible_v<T, U&&>
+    constexpr rs_option replace(U&& val) & noexcept(std::is_nothrow_move_constructible_v<some_type> and
+                                                    std::is_nothrow_constructible_v<T, U&&>)
+    {
+        rs_option old{std::move(*this)};
+        m_value.template emplace<some_type>(some_type{std::forward<U>(val)});
+        return old;
+    }
+
+    template<typename E>
+    constexpr auto ok_or(E&& e) const& noexcept(std::is_nothrow_copy_constructible_v<some_type> and
+                                                std::is_nothrow_constructible_v<std::decay_t<E>, E&&>)
+        -> rs_result<T, std::decay_t<E>>
+    {
+        using return_type = rs_result<T, std::decay_t<E>>;
+        if (is_some()) [[likely]]
+        {
+            return return_type{std::in_place_type<ok<T>>, inter_unwrap_some().m_value};
+        }
+        return return_type{std::in_place_type<err<std::decay_t<E>>>, std::forward<E>(e)};
+    }
+
+    template<typename E>
+    constexpr auto ok_or(E&& e) && noexcept(std::is_nothrow_move_constructible_v<some_type> and
+                                            std::is_nothrow_constructible_v<std::decay_t<E>, E&&>)
+        -> rs_result<T, std::decay_t<E>>
+    {
+        using return_type = rs_result<T, std::decay_t<E>>;
+        if (is_some()) [[likely]]
+        {
+            return return_type{std::in_place_type<ok<T>>, std::move(*this).unwrap_unchecked()};
+        }
+        return return_type{std::in_place_type<err<std::decay_t<E>>>, std::forward<E>(e)};
+    }
+
+    // Some pair when both are some. other is copied from or moved from as it
+    // is passed.
+    template<typename Other>
+        requires is_rs_option_v<std::remove_cvref_t<Other>>
+    constexpr auto zip(Other&& other) const&
+        -> rs_option<std::pair<T, typename std::remove_cvref_t<Other>::raw_some_type>>
+    {
+        using return_type = rs_option<std::pair<T, typename std::remove_cvref_t<Other>::raw_some_type>>;
+        if (is_some() and other.is_some())
+        {
+            return return_type{some<typename return_type::raw_some_type>{
+                {inter_unwrap_some().m_value, std::forward<Other>(other).unwrap_unchecked()}}};
+        }
+        return return_type{none{}};
+    }
+
+    template<typename Other>
+        requires is_rs_option_v<std::remove_cvref_t<Other>>
+    constexpr auto zip(Other&& other) && -> rs_option<std::pair<T, typename std::remove_cvref_t<Other>::raw_some_type>>
+    {
+        using return_type = rs_option<std::pair<T, typename std::remove_cvref_t<Other>::raw_some_type>>;
+        if (is_some() and other.is_some())
+        {
+            return return_type{some<typename return_type::raw_some_type>{
+                {std::move(*this).unwrap_unchecked(), std::forward<Other>(other).unwrap_unchecked()}}};
+        }
+        return return_type{none{}};
+    }
+
 private:
-    constexpr none inter_unwrap_none() const noexcept
+    constexpr const none& inter_unwrap_none() const noexcept
     {
-        return std::get<none>(m_value);
+        return m_value.template get<none>();
     }
 
-    constexpr some_type inter_unwrap_some() const noexcept
+    constexpr const some_type& inter_unwrap_some() const noexcept
     {
-        return std::get<some_type>(m_value);
+        return m_value.template get<some_type>();
     }
-    std::variant<some_type, none> m_value;
+    rs_storage<some_type, none> m_value;
+
+    static_assert(!std::is_trivially_copyable_v<T> or std::is_trivially_copyable_v<rs_storage<some_type, none>>,
+                  "rs_option of a trivially copyable payload must be trivially copyable");
+};
+
+template<typename T>
+struct is_trivially_relocatable<rs_option<T>>
+    : std::bool_constant<std::is_trivially_copyable_v<rs_option<T>> or is_trivially_relocatable_v<some<T>>>
+{
 };
 
 } // namespace hfl
\ No newline at end of file
@@ -1,8 +1,12 @@
 #pragma once
+#include "function_ref.hpp"
+#include "relocatable.hpp"
 #include "rs_common.hpp"
+#include "rs_storage.hpp"
 #include <exception>
 #include <functional>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <variant>
 
@@ -46,78 +50,146 @@ public:
     {
     }
 
-    constexpr explicit rs_result(std::in_place_type_t<ok_type>, raw_ok_type val) noexcept
-        : m_value(std::in_place_type<ok_type>, val)
+    // Builds the payload right in the storage from us.
+    template<typename... Us>
+    constexpr explicit rs_result(std::in_place_type_t<ok_type> alt, Us&&... us) noexcept(
+        std::is_nothrow_constructible_v<ok_type, Us&&...>)
+        : m_value(alt, std::forward<Us>(us)...)
     {
     }
 
-    constexpr rs_result() noexcept : m_value(ok<T>{})
+    template<typename... Us>
+    constexpr explicit rs_result(std::in_place_type_t<err_type> alt, Us&&... us) noexcept(
+        std::is_nothrow_constructible_v<err_type, Us&&...>)
+        : m_value(alt, std::forward<Us>(us)...)
     {
     }
 
-    constexpr rs_result(const ok_type& val) noexcept : m_value(val)
+    constexpr rs_result() noexcept : m_value(std::in_place_type<ok_type>)
     {
     }
 
-    constexpr rs_result(ok_type&& val) noexcept : m_value(std::move(val))
+    constexpr rs_result(const ok_type& val) noexcept : m_value(std::in_place_type<ok_type>, val)
     {
     }
-    constexpr rs_result(const err_type& val) noexcept : m_value(val)
+
+    constexpr rs_result(ok_type&& val) noexcept : m_value(std::in_place_type<ok_type>, std::move(val))
+    {
+    }
+    constexpr rs_result(const err_type& val) noexcept : m_value(std::in_place_type<err_type>, val)
     {
     }
 
-    constexpr rs_result(err_type&& val) noexcept : m_value(std::move(val))
+    constexpr rs_result(err_type&& val) noexcept : m_value(std::in_place_type<err_type>, std::move(val))
     {
     }
 
     constexpr bool is_ok() const noexcept
     {
-        return std::holds_alternative<ok_type>(m_value);
+        return m_value.template holds<ok_type>();
     }
 
     constexpr bool is_err() const noexcept
     {
-        return std::holds_alternative<err_type>(m_value);
+        return m_value.template holds<err_type>();
     }
 
     constexpr void set_ok(ok_type&& v) noexcept
     {
-        m_value = std::move(v);
+        m_value.template emplace<ok_type>(std::move(v));
     }
 
     constexpr void set_ok(const ok_type& v) noexcept
     {
-        m_value = v;
+        m_value.template emplace<ok_type>(v);
     }
 
     constexpr void set_err(err_type&& v) noexcept
     {
-        m_value = std::move(v);
+        m_value.template emplace<err_type>(std::move(v));
     }
 
     constexpr void set_err(const err_type& v) noexcept
     {
-        m_value = v;
+        m_value.template emplace<err_type>(v);
+    }
+
+    constexpr std::remove_cvref_t<T> unwrap() const&
+    {
+        if (is_err()) [[unlikely]]
+        {
+            unwrap_failed(inter_unwrap_err());
+        }
+
+        return m_value.template get<ok_type>().m_value;
+    }
+
+    constexpr T unwrap() &
+    {
+        if (is_err()) [[unlikely]]
+        {
+            unwrap_failed(inter_unwrap_err());
+        }
+
+        return m_value.template get<ok_type>().m_value;
     }
 
-    constexpr std::remove_cvref_t<T> unwrap() const
+    constexpr T unwrap() &&
     {
         if (is_err()) [[unlikely]]
         {
-            throw unwrap_exception{inter_unwrap_err()};
+            unwrap_failed(inter_unwrap_err());
         }
 
-        return std::get<ok_type>(m_value).m_value;
+        return std::move(m_value.template get<ok_type>()).m_value;
     }
 
-    constexpr T unwrap()
+    // Borrow the ok payload instead of copying it out, throws like unwrap.
+    constexpr const raw_ok_type& unwrap_ref() const&
     {
         if (is_err()) [[unlikely]]
         {
-            throw unwrap_exception{inter_unwrap_err()};
+            unwrap_failed(inter_unwrap_err());
         }
+        return m_value.template get<ok_type>().m_value;
+    }
 
-        return std::get<ok_type>(m_value).m_value;
+    constexpr std::add_lvalue_reference_t<T> unwrap_ref() &
+    {
+        if (is_err()) [[unlikely]]
+        {
+            unwrap_failed(inter_unwrap_err());
+        }
+        return m_value.template get<ok_type>().m_value;
+    }
+
+    constexpr std::add_rvalue_reference_t<T> unwrap_ref() &&
+    {
+        if (is_err()) [[unlikely]]
+        {
+            unwrap_failed(inter_unwrap_err());
+        }
+        return std::move(m_value.template get<ok_type>()).m_value;
+    }
+
+    // Unchecked borrows for code that already tested is_ok(), calling them on
+    // an err is undefined behavior.
+    constexpr const raw_ok_type& unwrap_unchecked() const& noexcept
+    {
+        HFL_ASSUME(is_ok());
+        return m_value.template get<ok_type>().m_value;
+    }
+
+    constexpr std::add_lvalue_reference_t<T> unwrap_unchecked() & noexcept
+    {
+        HFL_ASSUME(is_ok());
+        return m_value.template get<ok_type>().m_value;
+    }
+
+    constexpr std::add_rvalue_reference_t<T> unwrap_unchecked() && noexcept
+    {
+        HFL_ASSUME(is_ok());
+        return std::move(m_value.template get<ok_type>()).m_value;
     }
 
     template<typename U>
@@ -129,86 +201,145 @@ public:
             return val;
         }
 
-        return std::get<ok_type>(m_value).m_value;
+        return m_value.template get<ok_type>().m_value;
     }
 
-    constexpr E unwrap_err() const
+    constexpr E unwrap_err() const&
     {
         if (is_ok()) [[unlikely]]
         {
-            throw unwrap_err_exception{inter_unwrap_ok()};
+            unwrap_failed(inter_unwrap_ok());
         }
-        return std::get<err_type>(m_value).m_value;
+        return m_value.template get<err_type>().m_value;
+    }
+
+    constexpr E unwrap_err() &&
+    {
+        if (is_ok()) [[unlikely]]
+        {
+            unwrap_failed(inter_unwrap_ok());
+        }
+        return std::move(m_value.template get<err_type>()).m_value;
+    }
+
+    constexpr const raw_err_type& unwrap_err_ref() const&
+    {
+        if (is_ok()) [[unlikely]]
+        {
+            unwrap_failed(inter_unwrap_ok());
+        }
+        return m_value.template get<err_type>().m_value;
+    }
+
+    constexpr std::add_lvalue_reference_t<E> unwrap_err_ref() &
+    {
+        if (is_ok()) [[unlikely]]
+        {
+            unwrap_failed(inter_unwrap_ok());
+        }
+        return m_value.template get<err_type>().m_value;
+    }
+
+    constexpr std::add_rvalue_reference_t<E> unwrap_err_ref() &&
+    {
+        if (is_ok()) [[unlikely]]
+        {
+            unwrap_failed(inter_unwrap_ok());
+        }
+        return std::move(m_value.template get<err_type>()).m_value;
+    }
+
+    constexpr const raw_err_type& unwrap_err_unchecked() const& noexcept
+    {
+        HFL_ASSUME(is_err());
+        return m_value.template get<err_type>().m_value;
+    }
+
+    constexpr std::add_lvalue_reference_t<E> unwrap_err_unchecked() & noexcept
+    {
+        HFL_ASSUME(is_err());
+        return m_value.template get<err_type>().m_value;
+    }
+
+    constexpr std::add_rvalue_reference_t<E> unwrap_err_unchecked() && noexcept
+    {
+        HFL_ASSUME(is_err());
+        return std::move(m_value.template get<err_type>()).m_value;
     }
 
     template<typename OkFunc, typename ErrFunc>
-        requires std::is_invocable_v<OkFunc, ok_type&> and std::is_invocable_v<ErrFunc, err_type&>
+        requires std::is_invocable_v<OkFunc, ok_type&> and std::is_invocable_v<ErrFunc, err_type&> and
+                 (!is_function_ref_v<OkFunc> or !is_function_ref_v<ErrFunc>)
     constexpr decltype(auto) match(OkFunc&& val_func,
                                    ErrFunc&& err_func) & noexcept(std::is_nothrow_invocable_v<OkFunc, ok_type&> and
                                                                   std::is_nothrow_invocable_v<ErrFunc, err_type&>)
     {
         if (is_ok()) [[likely]]
         {
-            return std::invoke(std::forward<OkFunc>(val_func), std::get<ok_type>(m_value));
+            return std::invoke(std::forward<OkFunc>(val_func), m_value.template get<ok_type>());
         }
         else
         {
-            return std::invoke(std::forward<ErrFunc>(err_func), std::get<err_type>(m_value));
+            return std::invoke(std::forward<ErrFunc>(err_func), m_value.template get<err_type>());
         }
     }
 
     template<typename OkFunc, typename ErrFunc>
-        requires std::is_invocable_v<OkFunc, const ok_type&> and std::is_invocable_v<ErrFunc, const err_type&>
+        requires std::is_invocable_v<OkFunc, const ok_type&> and std::is_invocable_v<ErrFunc, const err_type&> and
+                 (!is_function_ref_v<OkFunc> or !is_function_ref_v<ErrFunc>)
     constexpr decltype(auto) match(OkFunc&& val_func, ErrFunc&& err_func) const& noexcept(
         std::is_nothrow_invocable_v<OkFunc, const ok_type&> and std::is_nothrow_invocable_v<ErrFunc, const err_type&>)
     {
         if (is_ok()) [[likely]]
         {
-            return val_func(std::get<ok_type>(m_value));
+            return val_func(m_value.template get<ok_type>());
         }
         else
         {
-            return err_func(std::get<err_type>(m_value));
+            return err_func(m_value.template get<err_type>());
         }
     }
 
     template<typename OkFunc, typename ErrFunc>
-        requires std::is_invocable_v<OkFunc, ok_type&&> and std::is_invocable_v<ErrFunc, err_type&&>
+        requires std::is_invocable_v<OkFunc, ok_type&&> and std::is_invocable_v<ErrFunc, err_type&&> and
+                 (!is_function_ref_v<OkFunc> or !is_function_ref_v<ErrFunc>)
     constexpr decltype(auto) match(OkFunc&& val_func,
                                    ErrFunc&& err_func) && noexcept(std::is_nothrow_invocable_v<OkFunc, ok_type&&> and
                                                                    std::is_nothrow_invocable_v<ErrFunc, err_type&&>)
     {
         if (is_ok()) [[likely]]
         {
-            return val_func(std::move(std::get<ok_type>(m_value)));
+            return val_func(std::move(m_value.template get<ok_type>()));
         }
         else
         {
-            return err_func(std::move(std::get<err_type>(m_value)));
+            return err_func(std::move(m_value.template get<err_type>()));
         }
     }
 
     template<typename OkFunc, typename ErrFunc>
-        requires std::is_invocable_v<OkFunc, const ok_type&&> and std::is_invocable_v<ErrFunc, const err_type&&>
+        requires std::is_invocable_v<OkFunc, const ok_type&&> and std::is_invocable_v<ErrFunc, const err_type&&> and
+                 (!is_function_ref_v<OkFunc> or !is_function_ref_v<ErrFunc>)
     constexpr decltype(auto) match(OkFunc&& val_func, ErrFunc&& err_func) const&& noexcept(
         std::is_nothrow_invocable_v<OkFunc, const ok_type&&> and std::is_nothrow_invocable_v<ErrFunc, const err_type&&>)
     {
         if (is_ok()) [[likely]]
         {
-            return val_func(std::move(std::get<ok_type>(m_value)));
+            return val_func(std::move(m_value.template get<ok_type>()));
         }
         else
         {
-            return err_func(std::move(std::get<err_type>(m_value)));
+            return err_func(std::move(m_value.template get<err_type>()));
         }
     }
 
-    void swap(rs_result& b) noexcept(std::is_nothrow_swappable_v<std::variant<ok_type, err_type>>)
+    constexpr void swap(rs_result& b) noexcept(std::is_nothrow_swappable_v<rs_storage<ok_type, err_type>>)
     {
         std::swap(m_value, b.m_value);
     }
 
-    friend void swap(rs_result& a, rs_result& b) noexcept(std::is_nothrow_swappable_v<std::variant<ok_type, err_type>>)
+    friend constexpr void swap(rs_result& a,
+                               rs_result& b) noexcept(std::is_nothrow_swappable_v<rs_storage<ok_type, err_type>>)
     {
         a.swap(b);
     }
@@ -236,8 +367,8 @@ public:
 
 
     template<typename Func>
-        requires std::is_invocable_v<Func, raw_ok_type>
-    auto map(Func&& f) const noexcept(std::is_nothrow_invocable_v<Func, raw_ok_type>)
+        requires std::is_invocable_v<Func, raw_ok_type> and (!is_function_ref_v<Func>)
+    constexpr auto map(Func&& f) const& noexcept(std::is_nothrow_invocable_v<Func, raw_ok_type>)
         -> rs_result<std::invoke_result_t<Func, T>, E>
     {
         using return_type = std::invoke_result_t<Func, T>;
@@ -248,9 +379,24 @@ public:
             [](const err_type& e) noexcept { return rs_result<return_type, E>{e}; });
     }
 
+    template<typename Func>
+        requires std::is_invocable_v<Func, T&&> and (!is_function_ref_v<Func>)
+    constexpr auto map(Func&& f) && noexcept(std::is_nothrow_invocable_v<Func, T&&>)
+        -> rs_result<std::invoke_result_t<Func, T&&>, E>
+    {
+        using return_type = std::invoke_result_t<Func, T&&>;
+        return std::move(*this).match(
+            [&f](ok_type&& v) noexcept(std::is_nothrow_invocable_v<Func, T&&>) {
+                return rs_result<return_type, E>{
+                    ok<return_type>{std::invoke(std::forward<Func>(f), std::move(v).m_value)}};
+            },
+            [](err_type&& e) noexcept { return rs_result<return_type, E>{std::move(e)}; });
+    }
+
     template<typename U, typename Func>
         requires std::is_invocable_r_v<U, Func, raw_ok_type>
-    auto map_or(U val, Func&& f) const noexcept(std::is_nothrow_invocable_r_v<U, Func, raw_ok_type>) -> U
+    constexpr auto map_or(U val, Func&& f) const& noexcept(std::is_nothrow_invocable_r_v<U, Func, raw_ok_type>)
+        -> U
     {
 
         return match(
@@ -260,9 +406,20 @@ public:
             [&val](const err_type&) noexcept { return val; });
     }
 
+    template<typename U, typename Func>
+        requires std::is_invocable_r_v<U, Func, T&&>
+    constexpr auto map_or(U val, Func&& f) && noexcept(std::is_nothrow_invocable_r_v<U, Func, T&&>) -> U
+    {
+        return std::move(*this).match(
+            [&f](ok_type&& v) noexcept(std::is_nothrow_invocable_r_v<U, Func, T&&>) -> U {
+                return std::invoke(std::forward<Func>(f), std::move(v).m_value);
+            },
+            [&val](err_type&&) noexcept -> U { return std::move(val); });
+    }
+
     template<typename UFunc, typename Func>
         requires std::is_invocable_r_v<std::invoke_result_t<UFunc>, UFunc>
-    auto map_or_else(UFunc&& uf, Func&& f) const
+    constexpr auto map_or_else(UFunc&& uf, Func&& f) const&
         noexcept(std::is_nothrow_invocable_r_v<raw_ok_type, Func, raw_ok_type> and
                  std::is_nothrow_invocable_r_v<raw_ok_type, UFunc>) -> std::invoke_result_t<UFunc>
     {
@@ -277,30 +434,64 @@ public:
             });
     }
 
+    template<typename UFunc, typename Func>
+        requires std::is_invocable_r_v<std::invoke_result_t<UFunc>, UFunc> and
+                 std::is_invocable_r_v<std::invoke_result_t<UFunc>, Func, T&&>
+    constexpr auto map_or_else(UFunc&& uf, Func&& f) && noexcept(std::is_nothrow_invocable_v<Func, T&&> and
+                                                                 std::is_nothrow_invocable_v<UFunc>)
+        -> std::invoke_result_t<UFunc>
+    {
+        using return_type = std::invoke_result_t<UFunc>;
+
+        return std::move(*this).match(
+            [&f](ok_type&& v) noexcept(std::is_nothrow_invocable_v<Func, T&&>) -> return_type {
+                return std::invoke(std::forward<Func>(f), std::move(v).m_value);
+            },
+            [&uf](err_type&&) noexcept(std::is_nothrow_invocable_v<UFunc>) -> return_type {
+                return std::invoke(std::forward<UFunc>(uf));
+            });
+    }
+
     template<typename EFunc>
-        requires std::is_invocable_v<EFunc, raw_ok_type>
-    auto map_err(EFunc&& f) const
-        noexcept(std::is_nothrow_constructible_v<rs_result<T, std::invoke_result_t<EFunc, E>>, ok_type> and
-                 std::is_nothrow_constructible_v<rs_result<T, std::invoke_result_t<EFunc, E>>, err_type>)
-            -> rs_result<T, std::invoke_result_t<EFunc, E>>
+        requires std::is_invocable_v<EFunc, raw_err_type>
+    constexpr auto map_err(EFunc&& f) const&
+        noexcept(std::is_nothrow_invocable_v<EFunc, const raw_err_type&> and
+                 std::is_nothrow_copy_constructible_v<ok_type>) -> rs_result<T, std::invoke_result_t<EFunc, E>>
     {
         using return_type = std::invoke_result_t<EFunc, E>;
         return match(
-            [](const ok_type& v) noexcept(
-                std::is_nothrow_constructible_v<rs_result<T, std::invoke_result_t<EFunc, E>>, ok_type>) {
+            [](const ok_type& v) noexcept(std::is_nothrow_copy_constructible_v<ok_type>) {
                 return rs_result<T, return_type>{v};
             },
-            [&f](const err_type& e) noexcept(
-                std::is_nothrow_constructible_v<rs_result<T, std::invoke_result_t<EFunc, E>>, err_type>) {
+            [&f](const err_type& e) noexcept(std::is_nothrow_invocable_v<EFunc, const raw_err_type&>) {
                 return rs_result<T, return_type>{err<return_type>{f(e.m_value)}};
             });
     }
 
+    template<typename EFunc>
+        requires std::is_invocable_v<EFunc, E&&>
+    constexpr auto map_err(EFunc&& f) && noexcept(std::is_nothrow_invocable_v<EFunc, E&&> and
+                                                  std::is_nothrow_move_constructible_v<ok_type>)
+        -> rs_result<T, std::invoke_result_t<EFunc, E&&>>
+    {
+        using return_type = std::invoke_result_t<EFunc, E&&>;
+        return std::move(*this).match(
+            [](ok_type&& v) noexcept(std::is_nothrow_move_constructible_v<ok_type>) {
+                return rs_result<T, return_type>{std::move(v)};
+            },
+            [&f](err_type&& e) noexcept(std::is_nothrow_invocable_v<EFunc, E&&>) {
+                return rs_result<T, return_type>{
+                    err<return_type>{std::invoke(std::forward<EFunc>(f), std::move(e).m_value)}};
+            });
+    }
+
     template<typename Func>
-        requires std::is_invocable_v<Func, raw_ok_type> and is_rs_result_v<std::invoke_result_t<Func, T>>
-    auto and_then(Func&& f) const noexcept(std::is_nothrow_invocable_v<Func, raw_ok_type> and
-                                           std::is_nothrow_constructible_v<std::invoke_result_t<Func, T>, err_type>)
-        -> std::invoke_result_t<Func, T>
+        requires std::is_invocable_v<Func, raw_ok_type> and is_rs_result_v<std::invoke_result_t<Func, T>> and
+                 (!is_function_ref_v<Func>)
+    constexpr auto and_then(Func&& f) const&
+        noexcept(std::is_nothrow_invocable_v<Func, raw_ok_type> and
+                 std::is_nothrow_constructible_v<std::invoke_result_t<Func, T>, err_type>)
+            -> std::invoke_result_t<Func, T>
     {
         using return_type = std::invoke_result_t<Func, T>;
         return match(
@@ -311,11 +502,110 @@ public:
     }
 
     template<typename Func>
-        requires std::is_invocable_v<Func, raw_err_type> and is_rs_result_v<std::invoke_result_t<Func, E>>
-    auto or_else(Func&& f) const noexcept -> std::invoke_result_t<Func, E>
+        requires std::is_invocable_v<Func, T&&> and is_rs_result_v<std::invoke_result_t<Func, T&&>> and
+                 (!is_function_ref_v<Func>)
+    constexpr auto and_then(Func&& f) &&
+        noexcept(std::is_nothrow_invocable_v<Func, T&&> and
+                 std::is_nothrow_constructible_v<std::invoke_result_t<Func, T&&>, err_type&&>)
+            -> std::invoke_result_t<Func, T&&>
+    {
+        using return_type = std::invoke_result_t<Func, T&&>;
+        return std::move(*this).match(
+            [&f](ok_type&& v) noexcept(std::is_nothrow_invocable_v<Func, T&&>) -> return_type {
+                return std::invoke(std::forward<Func>(f), std::move(v).m_value);
+            },
+            [](err_type&& e) noexcept(std::is_nothrow_constructible_v<return_type, err_type&&>) -> return_type {
+                return return_type{std::move(e)};
+            });
+    }
+
+    template<typename Func>
+        requires std::is_invocable_v<Func, raw_err_type> and is_rs_result_v<std::invoke_result_t<Func, E>> and
+                 (!is_function_ref_v<Func>)
+    constexpr auto or_else(Func&& f) const&
+        noexcept(std::is_nothrow_invocable_v<Func, const raw_err_type&> and
+                 std::is_nothrow_copy_constructible_v<ok_type>) -> std::invoke_result_t<Func, E>
     {
-        return match([](const ok_type& v) { return std::invoke_result_t<Func, E>{v}; },
-                     [&f](const err_type& e) { return f(e.m_value); });
+        using return_type = std::invoke_result_t<Func, E>;
+        return match(
+            [](const ok_type& v) noexcept(std::is_nothrow_copy_constructible_v<ok_type>) { return return_type{v}; },
+            [&f](const err_type& e) noexcept(std::is_nothrow_invocable_v<Func, const raw_err_type&>) -> return_type {
+                return f(e.m_value);
+            });
+    }
+
+    template<typename Func>
+        requires std::is_invocable_v<Func, E&&> and is_rs_result_v<std::invoke_result_t<Func, E&&>> and
+                 (!is_function_ref_v<Func>)
+    constexpr auto or_else(Func&& f) &&
+        noexcept(std::is_nothrow_invocable_v<Func, E&&> and
+                 std::is_nothrow_constructible_v<std::invoke_result_t<Func, E&&>, ok_type&&>)
+            -> std::invoke_result_t<Func, E&&>
+    {
+        using return_type = std::invoke_result_t<Func, E&&>;
+        return std::move(*this).match([](ok_type&& v) -> return_type { return return_type{std::move(v)}; },
+                                      [&f](err_type&& e) -> return_type {
+                                          return std::invoke(std::forward<Func>(f), std::move(e).m_value);
+                                      });
+    }
+
+    // function_ref overloads: every callable with the same signature shares
+    // one instantiation, which keeps cold paths small.
+    template<typename R, typename OkArg, typename ErrArg>
+        requires std::is_invocable_v<function_ref<R(OkArg)>, const ok_type&> and
+                 std::is_invocable_v<function_ref<R(ErrArg)>, const err_type&>
+    R match(function_ref<R(OkArg)> val_func, function_ref<R(ErrArg)> err_func) const&
+    {
+        if (is_ok()) [[likely]]
+        {
+            return val_func(m_value.template get<ok_type>());
+        }
+        return err_func(m_value.template get<err_type>());
+    }
+
+    template<typename R, typename OkArg, typename ErrArg>
+        requires std::is_invocable_v<function_ref<R(OkArg)>, ok_type&&> and
+                 std::is_invocable_v<function_ref<R(ErrArg)>, err_type&&>
+    R match(function_ref<R(OkArg)> val_func, function_ref<R(ErrArg)> err_func) &&
+    {
+        if (is_ok()) [[likely]]
+        {
+            return val_func(std::move(m_value.template get<ok_type>()));
+        }
+        return err_func(std::move(m_value.template get<err_type>()));
+    }
+
+    template<typename U, typename Arg>
+        requires std::is_invocable_v<function_ref<U(Arg)>, const raw_ok_type&>
+    auto map(function_ref<U(Arg)> f) const& -> rs_result<U, E>
+    {
+        if (is_ok()) [[likely]]
+        {
+            return rs_result<U, E>{ok<U>{f(m_value.template get<ok_type>().m_value)}};
+        }
+        return rs_result<U, E>{m_value.template get<err_type>()};
+    }
+
+    template<typename U, typename Arg>
+        requires std::is_invocable_v<function_ref<U(Arg)>, const raw_ok_type&> and is_rs_result_v<U>
+    auto and_then(function_ref<U(Arg)> f) const& -> U
+    {
+        if (is_ok()) [[likely]]
+        {
+            return f(m_value.template get<ok_type>().m_value);
+        }
+        return U{m_value.template get<err_type>()};
+    }
+
+    template<typename U, typename Arg>
+        requires std::is_invocable_v<function_ref<U(Arg)>, const raw_err_type&> and is_rs_result_v<U>
+    auto or_else(function_ref<U(Arg)> f) const& -> U
+    {
+        if (is_err())
+        {
+            return f(m_value.template get<err_type>().m_value);
+        }
+        return U{m_value.template get<ok_type>()};
     }
 
     constexpr auto as_mut() noexcept -> rs_result<raw_ok_type&, raw_err_type&>
@@ -340,7 +630,7 @@ public:
             });
     }
 
-    constexpr auto copied() const noexcept -> rs_result<raw_ok_type, raw_err_type>
+    constexpr auto copied() const& noexcept -> rs_result<raw_ok_type, raw_err_type>
     {
         if constexpr (std::is_copy_constructible_v<raw_ok_type>)
         {
@@ -359,30 +649,64 @@ public:
         }
     }
 
-    constexpr auto expect(const std::string& msg) const noexcept -> raw_ok_type
+    constexpr auto copied() && noexcept(std::is_nothrow_move_constructible_v<raw_ok_type> and
+                                        std::is_nothrow_move_constructible_v<raw_err_type>)
+        -> rs_result<raw_ok_type, raw_err_type>
     {
-        if (is_ok()) [[likely]]
+        return std::move(*this).match(
+            [](ok_type&& v) {
+                return rs_result<raw_ok_type, raw_err_type>{hfl::ok<raw_ok_type>{std::move(v).m_value}};
+            },
+            [](err_type&& e) {
+                return rs_result<raw_ok_type, raw_err_type>{hfl::err<raw_err_type>{std::move(e).m_value}};
+            });
+    }
+
+    // Returns a copy like unwrap, borrowing is what unwrap_ref is for.
+    constexpr auto expect(const std::string& msg) const& -> raw_ok_type
+    {
+        if (is_err()) [[unlikely]]
         {
-            return inter_unwrap_ok().m_value;
+            unwrap_failed(inter_unwrap_err(), msg.c_str());
         }
-        else
+        return inter_unwrap_ok().m_value;
+    }
+
+    constexpr auto expect(const std::string& msg) && -> raw_ok_type
+    {
+        if (is_err()) [[unlikely]]
         {
-            throw unwrap_exception{err_type{}};
+            unwrap_failed(inter_unwrap_err(), msg.c_str());
         }
+        return std::move(m_value.template get<ok_type>()).m_value;
     }
 
 private:
-    constexpr err_type inter_unwrap_err() const noexcept
+    constexpr const err_type& inter_unwrap_err() const noexcept
     {
-        return std::get<err_type>(m_value);
+        return m_value.template get<err_type>();
     }
 
-    constexpr ok_type inter_unwrap_ok() const noexcept
+    constexpr const ok_type& inter_unwrap_ok() const noexcept
     {
-        return std::get<ok_type>(m_value);
+        return m_value.template get<ok_type>();
     }
 
-    std::variant<ok_type, err_type> m_value;
+    rs_storage<ok_type, err_type> m_value;
+
+    // Trivial payloads give a trivially copyable result, which the ABI returns
+    // in registers and containers may memcpy. Reference payloads are not
+    // assignable and are left out.
+    static_assert(!(std::is_trivially_copyable_v<T> and std::is_trivially_copyable_v<E>) or
+                      std::is_trivially_copyable_v<rs_storage<ok_type, err_type>>,
+                  "rs_result of trivially copyable payloads must be trivially copyable");
+};
+
+template<typename T, typename E>
+struct is_trivially_relocatable<rs_result<T, E>>
+    : std::bool_constant<std::is_trivially_copyable_v<rs_result<T, E>> or
+                         (is_trivially_relocatable_v<ok<T>> and is_trivially_relocatable_v<err<E>>)>
+{
 };
 
 
@@ -430,16 +754,149 @@ constexpr decltype(auto) operator|(rs_result<T, E>&& res, Func&& f) noexcept(
     return mbind<T, E, Func>(std::move(res), std::forward<Func>(f));
 }
 
+// Payload and error type after a stage: a stage returning rs_result binds
+// like and_then, any other stage maps the payload and keeps the error.
+template<typename R, typename E>
+struct pipeline_stage_traits
+{
+    using payload_type = std::remove_cvref_t<R>;
+    using error_type = E;
+};
+
+template<typename R, typename E>
+    requires is_rs_result_v<std::remove_cvref_t<R>>
+struct pipeline_stage_traits<R, E>
+{
+    using payload_type = typename std::remove_cvref_t<R>::raw_ok_type;
+    using error_type = typename std::remove_cvref_t<R>::raw_err_type;
+};
+
+template<typename Arg, typename E, typename... Funcs>
+struct pipeline_result
+{
+    using type = rs_result<std::remove_cvref_t<Arg>, E>;
+};
+
+template<typename Arg, typename E, typename Func, typename... Funcs>
+struct pipeline_result<Arg, E, Func, Funcs...>
+{
+    using stage_traits = pipeline_stage_traits<std::invoke_result_t<const Func&, Arg&&>, E>;
+    using type = typename pipeline_result<typename stage_traits::payload_type&&, typename stage_traits::error_type,
+                                          Funcs...>::type;
+};
+
+// Lazily built pipeline: the stages are recorded as types and run in one
+// pass. Each payload is moved into the next stage, the first error jumps
+// straight to the final result type and only that result is built here,
+// instead of one rs_result per stage like a chain of operator|.
+template<typename... Funcs>
+class rs_pipeline
+{
+public:
+    template<typename... Fs>
+        requires(sizeof...(Fs) == sizeof...(Funcs)) and std::is_constructible_v<std::tuple<Funcs...>, Fs&&...>
+    constexpr explicit rs_pipeline(std::in_place_t, Fs&&... fs) : m_stages(std::forward<Fs>(fs)...)
+    {
+    }
+
+    template<typename... Fs>
+    constexpr explicit rs_pipeline(std::in_place_t, std::tuple<Fs...>&& stages) : m_stages(std::move(stages))
+    {
+    }
+
+    template<typename T, typename E>
+    constexpr auto operator()(const rs_result<T, E>& res) const
+    {
+        using return_type = typename pipeline_result<const typename rs_result<T, E>::raw_ok_type&, E, Funcs...>::type;
+        if (res.is_err()) [[unlikely]]
+        {
+            return fail<return_type>(res.unwrap_err_unchecked());
+        }
+        return run<return_type, 0>(res.unwrap_unchecked());
+    }
+
+    template<typename T, typename E>
+    constexpr auto operator()(rs_result<T, E>&& res) const
+    {
+        using return_type = typename pipeline_result<std::add_rvalue_reference_t<T>, E, Funcs...>::type;
+        if (res.is_err()) [[unlikely]]
+        {
+            return fail<return_type>(std::move(res).unwrap_err_unchecked());
+        }
+        return run<return_type, 0>(std::move(res).unwrap_unchecked());
+    }
+
+    template<typename G>
+    constexpr auto then(G&& g) const& -> rs_pipeline<Funcs..., std::decay_t<G>>
+    {
+        return rs_pipeline<Funcs..., std::decay_t<G>>{
+            std::in_place, std::tuple_cat(m_stages, std::tuple<std::decay_t<G>>{std::forward<G>(g)})};
+    }
+
+    template<typename G>
+    constexpr auto then(G&& g) && -> rs_pipeline<Funcs..., std::decay_t<G>>
+    {
+        return rs_pipeline<Funcs..., std::decay_t<G>>{
+            std::in_place, std::tuple_cat(std::move(m_stages), std::tuple<std::decay_t<G>>{std::forward<G>(g)})};
+    }
+
+private:
+    template<typename Result, typename Error>
+    static constexpr Result fail(Error&& e)
+    {
+        return Result{typename Result::err_type{std::forward<Error>(e)}};
+    }
+
+    template<typename Result, size_t I, typename Arg>
+    constexpr Result run(Arg&& arg) const
+    {
+        if constexpr (I == sizeof...(Funcs))
+        {
+            return Result{typename Result::ok_type{std::forward<Arg>(arg)}};
+        }
+        else
+        {
+            using stage_type = std::remove_cvref_t<std::invoke_result_t<const decltype(std::get<I>(m_stages))&, Arg&&>>;
+            if constexpr (!is_rs_result_v<stage_type>)
+            {
+                return run<Result, I + 1>(std::invoke(std::get<I>(m_stages), std::forward<Arg>(arg)));
+            }
+            else if constexpr (I + 1 == sizeof...(Funcs) and std::is_same_v<stage_type, Result>)
+            {
+                return std::invoke(std::get<I>(m_stages), std::forward<Arg>(arg));
+            }
+            else
+            {
+                stage_type stage = std::invoke(std::get<I>(m_stages), std::forward<Arg>(arg));
+                if (stage.is_err()) [[unlikely]]
+                {
+                    return fail<Result>(std::move(stage).unwrap_err_unchecked());
+                }
+                return run<Result, I + 1>(std::move(stage).unwrap_unchecked());
+            }
+        }
+    }
+
+    std::tuple<Funcs...> m_stages;
+};
+
+template<typename... Funcs>
+constexpr auto make_pipeline(Funcs&&... f) -> rs_pipeline<std::decay_t<Funcs>...>
+{
+    return rs_pipeline<std::decay_t<Funcs>...>{std::in_place, std::forward<Funcs>(f)...};
+}
+
+// Runs the stages through a fused rs_pipeline that refers to them in place.
 template<typename T, typename E, typename... Funcs>
-constexpr decltype(auto) pipeline(const rs_result<T, E>& res, Funcs&&... f)
+constexpr auto pipeline(const rs_result<T, E>& res, Funcs&&... f)
 {
-    return ((res | ... | std::forward<Funcs>(f)));
+    return rs_pipeline<std::remove_reference_t<Funcs>&...>{std::in_place, f...}(res);
 }
 
 template<typename T, typename E, typename... Funcs>
-constexpr decltype(auto) pipeline(rs_result<T, E>&& res, Funcs&&... f)
+constexpr auto pipeline(rs_result<T, E>&& res, Funcs&&... f)
 {
-    return ((std::move(res) | ... | std::forward<Funcs>(f)));
+    return rs_pipeline<std::remove_reference_t<Funcs>&...>{std::in_place, f...}(std::move(res));
 }
 
 template<typename T, typename E, typename OkFunc, typename ErrFunc>
@@ -0,0 +1,351 @@
+#pragma once
+#include "rs_common.hpp"
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace hfl
+{
+
+// A niche is a value of T that never occurs as a real payload, so it can
+// stand for the other alternative of a two-way sum and make the separate
+// discriminant unnecessary. Specialize this (or derive from sentinel_niche)
+// to declare one for your own types:
+//
+//   template<>
+//   struct hfl::niche_traits<color> : hfl::sentinel_niche<color, color::invalid>
+//   {
+//   };
+//
+// Storing the niche value itself reads back as the other alternative, so only
+// declare a value that can never be a real payload. Raw pointers may be null
+// and get no niche, use non_null<T> for pointers that never are.
+template<typename T>
+struct niche_traits
+{
+    static constexpr bool has_niche = false;
+};
+
+template<typename T, T Sentinel>
+struct sentinel_niche
+{
+    static constexpr bool has_niche = true;
+
+    static constexpr T niche() noexcept
+    {
+        return Sentinel;
+    }
+
+    static constexpr bool is_niche(const T& val) noexcept
+    {
+        return val == Sentinel;
+    }
+};
+
+// A pointer that is never null, which frees null to be the niche:
+// rs_option<non_null<T>> is one pointer wide. Constructing it from a null
+// pointer is a precondition violation.
+template<typename T>
+class non_null
+{
+public:
+    constexpr explicit non_null(T* ptr) noexcept : m_ptr(ptr)
+    {
+    }
+
+    non_null(std::nullptr_t) = delete;
+
+    constexpr T* get() const noexcept
+    {
+        return m_ptr;
+    }
+
+    constexpr T& operator*() const noexcept
+    {
+        return *m_ptr;
+    }
+
+    constexpr T* operator->() const noexcept
+    {
+        return m_ptr;
+    }
+
+    friend constexpr bool operator==(non_null a, non_null b) noexcept
+    {
+        return a.m_ptr == b.m_ptr;
+    }
+
+private:
+    friend struct niche_traits<non_null>;
+
+    constexpr non_null() noexcept = default;
+
+    T* m_ptr{nullptr};
+};
+
+template<typename T>
+struct niche_traits<non_null<T>>
+{
+    static constexpr bool has_niche = true;
+
+    static constexpr non_null<T> niche() noexcept
+    {
+        return non_null<T>{};
+    }
+
+    static constexpr bool is_niche(const non_null<T>& val) noexcept
+    {
+        return val.m_ptr == nullptr;
+    }
+};
+
+template<typename T, template<typename> typename Wrapper>
+struct wrapper_niche_traits
+{
+    static constexpr bool has_niche = niche_traits<T>::has_niche;
+
+    static constexpr Wrapper<T> niche() noexcept
+    {
+        return Wrapper<T>{niche_traits<T>::niche()};
+    }
+
+    static constexpr bool is_niche(const Wrapper<T>& val) noexcept
+    {
+        return niche_traits<T>::is_niche(val.m_value);
+    }
+};
+
+template<typename T>
+struct niche_traits<ok<T>> : wrapper_niche_traits<T, ok>
+{
+};
+
+template<typename T>
+struct niche_traits<err<T>> : wrapper_niche_traits<T, err>
+{
+};
+
+template<typename T>
+struct niche_traits<some<T>> : wrapper_niche_traits<T, some>
+{
+};
+
+// Carrier can hold the whole sum when it has a niche and the other
+// alternative carries no state.
+template<typename Carrier, typename Empty>
+constexpr bool niche_fits_v = niche_traits<Carrier>::has_niche and std::is_empty_v<Empty> and
+                              std::is_default_constructible_v<Empty> and !std::is_same_v<Carrier, Empty>;
+
+// Two-way sum without a discriminant: the alternative at CarrierIndex is
+// stored, the other one is encoded as the carrier's niche value.
+template<typename A, typename B, size_t CarrierIndex>
+class niche_storage
+{
+    using carrier_type = std::conditional_t<CarrierIndex == 0, A, B>;
+    using empty_type = std::conditional_t<CarrierIndex == 0, B, A>;
+    using traits = niche_traits<carrier_type>;
+
+public:
+    template<typename... Us>
+    constexpr explicit niche_storage(std::in_place_type_t<carrier_type>, Us&&... us) noexcept(
+        std::is_nothrow_constructible_v<carrier_type, Us&&...>)
+        : m_carrier(std::forward<Us>(us)...)
+    {
+    }
+
+    template<typename... Us>
+    constexpr explicit niche_storage(std::in_place_type_t<empty_type>, Us&&...) noexcept
+        : m_carrier(traits::niche())
+    {
+    }
+
+    template<typename Alt>
+    constexpr bool holds() const noexcept
+    {
+        if constexpr (std::is_same_v<Alt, carrier_type>)
+        {
+            return !traits::is_niche(m_carrier);
+        }
+        else
+        {
+            return traits::is_niche(m_carrier);
+        }
+    }
+
+    template<typename Alt>
+    constexpr Alt& get() noexcept
+    {
+        if constexpr (std::is_same_v<Alt, carrier_type>)
+        {
+            return m_carrier;
+        }
+        else
+        {
+            return m_empty;
+        }
+    }
+
+    template<typename Alt>
+    constexpr const Alt& get() const noexcept
+    {
+        if constexpr (std::is_same_v<Alt, carrier_type>)
+        {
+            return m_carrier;
+        }
+        else
+        {
+            return m_empty;
+        }
+    }
+
+    template<typename Alt, typename... Us>
+    constexpr void emplace(Us&&... us) noexcept(std::is_nothrow_constructible_v<Alt, Us&&...>)
+    {
+        if constexpr (std::is_same_v<Alt, carrier_type>)
+        {
+            m_carrier = carrier_type(std::forward<Us>(us)...);
+        }
+        else
+        {
+            m_carrier = traits::niche();
+        }
+    }
+
+private:
+    carrier_type m_carrier;
+    HFL_NO_UNIQUE_ADDRESS empty_type m_empty{};
+};
+
+// Two-way sum of trivially copyable alternatives: a union and a bool. It is
+// trivially copyable by construction, and unlike std::variant GCC builds it
+// directly in the return registers instead of going through the stack.
+template<typename A, typename B>
+class trivial_storage
+{
+public:
+    template<typename... Us>
+    constexpr explicit trivial_storage(std::in_place_type_t<A>, Us&&... us) noexcept(
+        std::is_nothrow_constructible_v<A, Us&&...>)
+        : m_a(std::forward<Us>(us)...), m_holds_b(false)
+    {
+    }
+
+    template<typename... Us>
+    constexpr explicit trivial_storage(std::in_place_type_t<B>, Us&&... us) noexcept(
+        std::is_nothrow_constructible_v<B, Us&&...>)
+        : m_b(std::forward<Us>(us)...), m_holds_b(true)
+    {
+    }
+
+    template<typename Alt>
+    constexpr bool holds() const noexcept
+    {
+        return std::is_same_v<Alt, B> == m_holds_b;
+    }
+
+    template<typename Alt>
+    constexpr Alt& get() noexcept
+    {
+        if constexpr (std::is_same_v<Alt, A>)
+        {
+            return m_a;
+        }
+        else
+        {
+            return m_b;
+        }
+    }
+
+    template<typename Alt>
+    constexpr const Alt& get() const noexcept
+    {
+        if constexpr (std::is_same_v<Alt, A>)
+        {
+            return m_a;
+        }
+        else
+        {
+            return m_b;
+        }
+    }
+
+    template<typename Alt, typename... Us>
+    constexpr void emplace(Us&&... us) noexcept(std::is_nothrow_constructible_v<Alt, Us&&...>)
+    {
+        std::construct_at(&get<Alt>(), std::forward<Us>(us)...);
+        m_holds_b = std::is_same_v<Alt, B>;
+    }
+
+private:
+    union
+    {
+        A m_a;
+        B m_b;
+    };
+    bool m_holds_b;
+};
+
+template<typename A, typename B>
+constexpr bool trivial_storage_fits_v =
+    std::is_trivially_copyable_v<A> and std::is_trivially_copyable_v<B> and !std::is_same_v<A, B>;
+
+// General two-way sum, the discriminant lives next to the payload.
+template<typename A, typename B>
+class variant_storage
+{
+public:
+    template<typename Alt, typename... Us>
+    constexpr explicit variant_storage(std::in_place_type_t<Alt> alt, Us&&... us) noexcept(
+        std::is_nothrow_constructible_v<Alt, Us&&...>)
+        : m_value(alt, std::forward<Us>(us)...)
+    {
+    }
+
+    template<typename Alt>
+    constexpr bool holds() const noexcept
+    {
+        return std::holds_alternative<Alt>(m_value);
+    }
+
+    // get_if keeps the unchecked access free of the bad_variant_access path,
+    // but GCC does not constant-evaluate its null check, so constant
+    // evaluation goes through std::get.
+    template<typename Alt>
+    constexpr Alt& get() noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            return std::get<Alt>(m_value);
+        }
+        return *std::get_if<Alt>(&m_value);
+    }
+
+    template<typename Alt>
+    constexpr const Alt& get() const noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            return std::get<Alt>(m_value);
+        }
+        return *std::get_if<Alt>(&m_value);
+    }
+
+    template<typename Alt, typename... Us>
+    constexpr void emplace(Us&&... us) noexcept(std::is_nothrow_constructible_v<Alt, Us&&...>)
+    {
+        m_value.template emplace<Alt>(std::forward<Us>(us)...);
+    }
+
+private:
+    std::variant<A, B> m_value;
+};
+
+template<typename A, typename B>
+using rs_storage = std::conditional_t<
+    niche_fits_v<A, B>, niche_storage<A, B, 0>,
+    std::conditional_t<niche_fits_v<B, A>, niche_storage<A, B, 1>,
+                       std::conditional_t<trivial_storage_fits_v<A, B>, trivial_storage<A, B>, variant_storage<A, B>>>>;
+
+} // namespace hfl
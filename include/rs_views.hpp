@@ -0,0 +1,634 @@
+#pragma once
+#include "rs_option.hpp"
+#include "rs_result.hpp"
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+// Lazy views over ranges of rs_result, rs_option and std::optional. They are
+// built from std::views::filter and std::views::transform, or from a caching
+// filter when the elements are produced on the fly, so a chain of them runs as
+// one loop without intermediate containers and computes every element once:
+//
+//   for (int port : lines | hfl::views::try_transform(parse_port) | hfl::views::transform_ok(check)) ...
+//
+//   oks              payloads of the ok / some elements
+//   errs             errors of the err elements
+//   transform_ok(f)  f applied to the payloads, errors pass through
+//   and_then(f)      f returning a result applied to the payloads
+//   take_while_ok    payloads up to the first err / none
+//   try_transform(f) payloads of f(x) up to the first error, which the view
+//                    keeps for error() once iteration stopped
+
+namespace hfl
+{
+
+// How the views read one element kind. value and error hand out references
+// into the element, failure gives what builds the same failure in another
+// element of the same kind.
+template<typename X>
+struct view_element;
+
+template<typename T, typename E>
+struct view_element<rs_result<T, E>>
+{
+    template<typename U>
+    using rebind = rs_result<U, E>;
+
+    static constexpr bool is_ok(const rs_result<T, E>& x) noexcept
+    {
+        return x.is_ok();
+    }
+
+    template<typename X>
+    static constexpr decltype(auto) value(X&& x) noexcept
+    {
+        return std::forward<X>(x).unwrap_unchecked();
+    }
+
+    template<typename X>
+    static constexpr decltype(auto) error(X&& x) noexcept
+    {
+        return std::forward<X>(x).unwrap_err_unchecked();
+    }
+
+    template<typename X>
+    static constexpr auto failure(X&& x)
+    {
+        return err<E>{std::forward<X>(x).unwrap_err_unchecked()};
+    }
+
+    template<typename U, typename V>
+    static constexpr rebind<U> success(V&& v)
+    {
+        return rebind<U>{ok<U>{std::forward<V>(v)}};
+    }
+};
+
+template<typename T>
+struct view_element<rs_option<T>>
+{
+    template<typename U>
+    using rebind = rs_option<U>;
+
+    static constexpr bool is_ok(const rs_option<T>& x) noexcept
+    {
+        return x.is_some();
+    }
+
+    template<typename X>
+    static constexpr decltype(auto) value(X&& x) noexcept
+    {
+        return std::forward<X>(x).unwrap_unchecked();
+    }
+
+    template<typename X>
+    static constexpr none failure(X&&) noexcept
+    {
+        return none{};
+    }
+
+    template<typename U, typename V>
+    static constexpr rebind<U> success(V&& v)
+    {
+        return rebind<U>{some<U>{std::forward<V>(v)}};
+    }
+};
+
+template<typename T>
+struct view_element<std::optional<T>>
+{
+    template<typename U>
+    using rebind = std::optional<U>;
+
+    static constexpr bool is_ok(const std::optional<T>& x) noexcept
+    {
+        return x.has_value();
+    }
+
+    template<typename X>
+    static constexpr decltype(auto) value(X&& x) noexcept
+    {
+        return *std::forward<X>(x);
+    }
+
+    template<typename X>
+    static constexpr std::nullopt_t failure(X&&) noexcept
+    {
+        return std::nullopt;
+    }
+
+    template<typename U, typename V>
+    static constexpr rebind<U> success(V&& v)
+    {
+        return rebind<U>{std::in_place, std::forward<V>(v)};
+    }
+};
+
+template<typename X>
+concept view_element_type = requires { sizeof(view_element<std::remove_cvref_t<X>>); };
+
+template<typename X>
+concept view_error_element_type = is_rs_result_v<std::remove_cvref_t<X>>;
+
+template<typename Range>
+concept element_range = std::ranges::input_range<Range> and view_element_type<std::ranges::range_reference_t<Range>>;
+
+template<typename X>
+using view_element_traits = view_element<std::remove_cvref_t<X>>;
+
+struct element_is_ok
+{
+    template<typename X>
+    constexpr bool operator()(const X& x) const noexcept
+    {
+        return view_element_traits<X>::is_ok(x);
+    }
+};
+
+struct element_is_err
+{
+    template<typename X>
+    constexpr bool operator()(const X& x) const noexcept
+    {
+        return !view_element_traits<X>::is_ok(x);
+    }
+};
+
+// Payloads of elements the range holds are handed out by reference, those of
+// elements produced on the fly (an earlier transform) by value.
+struct element_value
+{
+    template<typename X>
+    constexpr decltype(auto) operator()(X&& x) const
+    {
+        if constexpr (std::is_lvalue_reference_v<X>)
+        {
+            return view_element_traits<X>::value(x);
+        }
+        else
+        {
+            using value_type = std::remove_cvref_t<decltype(view_element_traits<X>::value(std::move(x)))>;
+            return value_type{view_element_traits<X>::value(std::move(x))};
+        }
+    }
+};
+
+struct element_error
+{
+    template<typename X>
+    constexpr decltype(auto) operator()(X&& x) const
+    {
+        if constexpr (std::is_lvalue_reference_v<X>)
+        {
+            return view_element_traits<X>::error(x);
+        }
+        else
+        {
+            using error_type = std::remove_cvref_t<decltype(view_element_traits<X>::error(std::move(x)))>;
+            return error_type{view_element_traits<X>::error(std::move(x))};
+        }
+    }
+};
+
+template<typename Func>
+struct element_map
+{
+    template<typename X>
+    constexpr auto operator()(X&& x) const
+    {
+        using traits = view_element_traits<X>;
+        using value_type = std::invoke_result_t<const Func&, decltype(element_value{}(std::forward<X>(x)))>;
+        using return_type = typename traits::template rebind<value_type>;
+        if (!traits::is_ok(x)) [[unlikely]]
+        {
+            return return_type{traits::failure(std::forward<X>(x))};
+        }
+        return traits::template success<value_type>(std::invoke(m_func, element_value{}(std::forward<X>(x))));
+    }
+
+    Func m_func;
+};
+
+template<typename Func>
+struct element_bind
+{
+    template<typename X>
+    constexpr auto operator()(X&& x) const
+    {
+        using traits = view_element_traits<X>;
+        using return_type =
+            std::remove_cvref_t<std::invoke_result_t<const Func&, decltype(element_value{}(std::forward<X>(x)))>>;
+        if (!traits::is_ok(x)) [[unlikely]]
+        {
+            return return_type{traits::failure(std::forward<X>(x))};
+        }
+        return return_type{std::invoke(m_func, element_value{}(std::forward<X>(x)))};
+    }
+
+    Func m_func;
+};
+
+// Range adaptor closure: range | closure and closure(range) both apply it,
+// closure | closure composes.
+template<typename Adaptor>
+class view_closure
+{
+public:
+    constexpr explicit view_closure(Adaptor adaptor) noexcept(std::is_nothrow_move_constructible_v<Adaptor>)
+        : m_adaptor(std::move(adaptor))
+    {
+    }
+
+    template<std::ranges::viewable_range Range>
+        requires std::is_invocable_v<const Adaptor&, Range&&>
+    constexpr auto operator()(Range&& range) const
+    {
+        return m_adaptor(std::forward<Range>(range));
+    }
+
+    template<std::ranges::viewable_range Range>
+        requires std::is_invocable_v<const Adaptor&, Range&&>
+    friend constexpr auto operator|(Range&& range, const view_closure& closure)
+    {
+        return closure.m_adaptor(std::forward<Range>(range));
+    }
+
+    template<typename Other>
+    friend constexpr auto operator|(view_closure first, view_closure<Other> second)
+    {
+        return view_closure<composed<Other>>{composed<Other>{std::move(first), std::move(second)}};
+    }
+
+private:
+    template<typename Other>
+    struct composed
+    {
+        template<typename Range>
+        constexpr auto operator()(Range&& range) const
+        {
+            return std::forward<Range>(range) | m_first | m_second;
+        }
+
+        view_closure m_first;
+        view_closure<Other> m_second;
+    };
+
+    Adaptor m_adaptor;
+};
+
+// Single-pass filter for ranges that produce their elements on the fly. Each
+// element is dereferenced once and cached in the iterator, and the accepted
+// ones are handed out through Proj, so the work that produced them is never
+// repeated the way filter's predicate followed by the caller's dereference
+// would. With StopAtReject the view ends at the first rejected element
+// instead of skipping it.
+template<std::ranges::input_range View, typename Pred, typename Proj, bool StopAtReject>
+    requires std::ranges::view<View>
+class element_cache_view : public std::ranges::view_interface<element_cache_view<View, Pred, Proj, StopAtReject>>
+{
+    using element_type = std::remove_cvref_t<std::ranges::range_reference_t<View>>;
+
+public:
+    class iterator
+    {
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = std::remove_cvref_t<std::invoke_result_t<Proj, element_type&>>;
+        using difference_type = std::ranges::range_difference_t<View>;
+
+        iterator() = default;
+
+        constexpr iterator(std::ranges::iterator_t<View> current, std::ranges::sentinel_t<View> end)
+            : m_current(std::move(current)), m_end(std::move(end))
+        {
+            satisfy();
+        }
+
+        // A reference into the cached element, valid until the next increment.
+        constexpr decltype(auto) operator*() const
+        {
+            return Proj{}(*m_element);
+        }
+
+        constexpr iterator& operator++()
+        {
+            ++m_current;
+            satisfy();
+            return *this;
+        }
+
+        constexpr void operator++(int)
+        {
+            ++*this;
+        }
+
+        friend constexpr bool operator==(const iterator& it, std::default_sentinel_t) noexcept
+        {
+            return !it.m_element.has_value();
+        }
+
+    private:
+        constexpr void satisfy()
+        {
+            for (; m_current != m_end; ++m_current)
+            {
+                if (Pred{}(m_element.emplace(*m_current)))
+                {
+                    return;
+                }
+                if constexpr (StopAtReject)
+                {
+                    break;
+                }
+            }
+            m_element.reset();
+        }
+
+        std::ranges::iterator_t<View> m_current{};
+        std::ranges::sentinel_t<View> m_end{};
+        // mutable so a const iterator hands out the same reference type.
+        mutable std::optional<element_type> m_element;
+    };
+
+    constexpr explicit element_cache_view(View base) : m_base(std::move(base))
+    {
+    }
+
+    constexpr iterator begin()
+    {
+        return iterator{std::ranges::begin(m_base), std::ranges::end(m_base)};
+    }
+
+    constexpr std::default_sentinel_t end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+private:
+    View m_base;
+};
+
+// Single-pass view of the payloads of f(x), ending at the first error. The
+// error stays in the view and can be read with error() after the loop.
+//
+// f, the current payload and the error live in one heap block that the
+// iterators point to, so moving the view keeps its live iterators valid. A
+// copy gets a block of its own with a copy of f.
+template<std::ranges::input_range View, typename Func>
+    requires std::ranges::view<View> and std::is_object_v<Func> and
+             std::is_invocable_v<Func&, std::ranges::range_reference_t<View>> and
+             is_rs_result_v<std::remove_cvref_t<std::invoke_result_t<Func&, std::ranges::range_reference_t<View>>>>
+class try_transform_view : public std::ranges::view_interface<try_transform_view<View, Func>>
+{
+    using stage_type = std::remove_cvref_t<std::invoke_result_t<Func&, std::ranges::range_reference_t<View>>>;
+
+public:
+    using payload_type = typename stage_type::raw_ok_type;
+    using error_type = typename stage_type::raw_err_type;
+
+private:
+    struct state
+    {
+        Func m_func;
+        std::optional<payload_type> m_payload;
+        std::optional<error_type> m_error;
+    };
+
+public:
+    class iterator
+    {
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = payload_type;
+        using difference_type = std::ranges::range_difference_t<View>;
+
+        iterator() = default;
+
+        constexpr iterator(state& s, std::ranges::iterator_t<View> current, std::ranges::sentinel_t<View> end)
+            : m_state(&s), m_current(std::move(current)), m_end(std::move(end))
+        {
+            fill();
+        }
+
+        constexpr payload_type& operator*() const noexcept
+        {
+            return *m_state->m_payload;
+        }
+
+        constexpr iterator& operator++()
+        {
+            ++m_current;
+            fill();
+            return *this;
+        }
+
+        constexpr void operator++(int)
+        {
+            ++*this;
+        }
+
+        friend constexpr bool operator==(const iterator& it, std::default_sentinel_t) noexcept
+        {
+            return !it.m_state->m_payload.has_value();
+        }
+
+    private:
+        constexpr void fill()
+        {
+            m_state->m_payload.reset();
+            if (m_current == m_end)
+            {
+                return;
+            }
+            stage_type stage = std::invoke(m_state->m_func, *m_current);
+            if (stage.is_err()) [[unlikely]]
+            {
+                m_state->m_error.emplace(std::move(stage).unwrap_err_unchecked());
+                return;
+            }
+            m_state->m_payload.emplace(std::move(stage).unwrap_unchecked());
+        }
+
+        state* m_state{nullptr};
+        std::ranges::iterator_t<View> m_current{};
+        std::ranges::sentinel_t<View> m_end{};
+    };
+
+    try_transform_view(View base, Func f)
+        : m_base(std::move(base)), m_state(std::make_unique<state>(state{std::move(f), {}, {}}))
+    {
+    }
+
+    try_transform_view(const try_transform_view& other)
+        : m_base(other.m_base), m_state(std::make_unique<state>(state{other.m_state->m_func, {}, {}}))
+    {
+    }
+
+    try_transform_view(try_transform_view&&) noexcept = default;
+
+    try_transform_view& operator=(const try_transform_view& other)
+    {
+        if (this != &other)
+        {
+            *this = try_transform_view{other};
+        }
+        return *this;
+    }
+
+    try_transform_view& operator=(try_transform_view&&) noexcept = default;
+
+    iterator begin()
+    {
+        m_state->m_error.reset();
+        return iterator{*m_state, std::ranges::begin(m_base), std::ranges::end(m_base)};
+    }
+
+    constexpr std::default_sentinel_t end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+    // The error that ended the iteration, if any.
+    const std::optional<error_type>& error() const noexcept
+    {
+        return m_state->m_error;
+    }
+
+private:
+    View m_base;
+    std::unique_ptr<state> m_state;
+};
+
+template<typename Range, typename Func>
+try_transform_view(Range&&, Func) -> try_transform_view<std::views::all_t<Range>, Func>;
+
+namespace views
+{
+
+struct oks_adaptor
+{
+    template<std::ranges::viewable_range Range>
+        requires element_range<Range>
+    constexpr auto operator()(Range&& range) const
+    {
+        if constexpr (std::is_lvalue_reference_v<std::ranges::range_reference_t<Range>>)
+        {
+            return std::views::transform(std::views::filter(std::forward<Range>(range), element_is_ok{}),
+                                         element_value{});
+        }
+        else
+        {
+            return element_cache_view<std::views::all_t<Range>, element_is_ok, element_value, false>{
+                std::views::all(std::forward<Range>(range))};
+        }
+    }
+};
+
+struct errs_adaptor
+{
+    template<std::ranges::viewable_range Range>
+        requires element_range<Range> and view_error_element_type<std::ranges::range_reference_t<Range>>
+    constexpr auto operator()(Range&& range) const
+    {
+        if constexpr (std::is_lvalue_reference_v<std::ranges::range_reference_t<Range>>)
+        {
+            return std::views::transform(std::views::filter(std::forward<Range>(range), element_is_err{}),
+                                         element_error{});
+        }
+        else
+        {
+            return element_cache_view<std::views::all_t<Range>, element_is_err, element_error, false>{
+                std::views::all(std::forward<Range>(range))};
+        }
+    }
+};
+
+struct take_while_ok_adaptor
+{
+    template<std::ranges::viewable_range Range>
+        requires element_range<Range>
+    constexpr auto operator()(Range&& range) const
+    {
+        if constexpr (std::is_lvalue_reference_v<std::ranges::range_reference_t<Range>>)
+        {
+            return std::views::transform(std::views::take_while(std::forward<Range>(range), element_is_ok{}),
+                                         element_value{});
+        }
+        else
+        {
+            return element_cache_view<std::views::all_t<Range>, element_is_ok, element_value, true>{
+                std::views::all(std::forward<Range>(range))};
+        }
+    }
+};
+
+template<typename Func>
+struct transform_ok_adaptor
+{
+    template<std::ranges::viewable_range Range>
+        requires element_range<Range>
+    constexpr auto operator()(Range&& range) const
+    {
+        return std::views::transform(std::forward<Range>(range), element_map<Func>{m_func});
+    }
+
+    Func m_func;
+};
+
+template<typename Func>
+struct and_then_adaptor
+{
+    template<std::ranges::viewable_range Range>
+        requires element_range<Range>
+    constexpr auto operator()(Range&& range) const
+    {
+        return std::views::transform(std::forward<Range>(range), element_bind<Func>{m_func});
+    }
+
+    Func m_func;
+};
+
+template<typename Func>
+struct try_transform_adaptor
+{
+    template<std::ranges::viewable_range Range>
+        requires std::ranges::input_range<Range>
+    constexpr auto operator()(Range&& range) const
+    {
+        return try_transform_view<std::views::all_t<Range>, Func>{std::views::all(std::forward<Range>(range)), m_func};
+    }
+
+    Func m_func;
+};
+
+inline constexpr view_closure<oks_adaptor> oks{oks_adaptor{}};
+inline constexpr view_closure<errs_adaptor> errs{errs_adaptor{}};
+inline constexpr view_closure<take_while_ok_adaptor> take_while_ok{take_while_ok_adaptor{}};
+
+template<typename Func>
+constexpr auto transform_ok(Func&& f)
+{
+    return view_closure{transform_ok_adaptor<std::decay_t<Func>>{std::forward<Func>(f)}};
+}
+
+template<typename Func>
+constexpr auto and_then(Func&& f)
+{
+    return view_closure{and_then_adaptor<std::decay_t<Func>>{std::forward<Func>(f)}};
+}
+
+template<typename Func>
+constexpr auto try_transform(Func&& f)
+{
+    return view_closure{try_transform_adaptor<std::decay_t<Func>>{std::forward<Func>(f)}};
+}
+
+} // namespace views
+
+} // namespace hfl
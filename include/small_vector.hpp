@@ -0,0 +1,302 @@
+#pragma once
+#include "relocatable.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace hfl
+{
+
+// Vector that keeps its first N elements inline and only allocates once it
+// grows past them. Growing relocates the elements, with a memcpy for
+// trivially relocatable types.
+template<typename T, size_t N>
+    requires(N > 0)
+class small_vector
+{
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    small_vector() noexcept = default;
+
+    small_vector(std::initializer_list<T> init)
+    {
+        reserve(init.size());
+        for (const T& v : init)
+        {
+            emplace_back(v);
+        }
+    }
+
+    small_vector(const small_vector& other)
+    {
+        reserve(other.m_size);
+        for (const T& v : other)
+        {
+            emplace_back(v);
+        }
+    }
+
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        take(std::move(other));
+    }
+
+    small_vector& operator=(const small_vector& other)
+    {
+        if (this != &other)
+        {
+            small_vector copy{other};
+            clear();
+            release();
+            take(std::move(copy));
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            release();
+            take(std::move(other));
+        }
+        return *this;
+    }
+
+    ~small_vector()
+    {
+        clear();
+        release();
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (m_size == m_capacity) [[unlikely]]
+        {
+            return grow_and_emplace_back(std::forward<Args>(args)...);
+        }
+        T* slot = std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+        ++m_size;
+        return *slot;
+    }
+
+    void push_back(const T& v)
+    {
+        emplace_back(v);
+    }
+
+    void push_back(T&& v)
+    {
+        emplace_back(std::move(v));
+    }
+
+    void pop_back() noexcept
+    {
+        std::destroy_at(m_data + --m_size);
+    }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity > m_capacity)
+        {
+            grow(capacity);
+        }
+    }
+
+    void clear() noexcept
+    {
+        std::destroy_n(m_data, m_size);
+        m_size = 0;
+    }
+
+    size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    // Whether the elements still live in the inline buffer.
+    bool is_inline() const noexcept
+    {
+        return m_data == inline_data();
+    }
+
+    T* data() noexcept
+    {
+        return m_data;
+    }
+
+    const T* data() const noexcept
+    {
+        return m_data;
+    }
+
+    T& operator[](size_t i) noexcept
+    {
+        return m_data[i];
+    }
+
+    const T& operator[](size_t i) const noexcept
+    {
+        return m_data[i];
+    }
+
+    T& back() noexcept
+    {
+        return m_data[m_size - 1];
+    }
+
+    const T& back() const noexcept
+    {
+        return m_data[m_size - 1];
+    }
+
+    iterator begin() noexcept
+    {
+        return m_data;
+    }
+
+    iterator end() noexcept
+    {
+        return m_data + m_size;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return m_data;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+    friend bool operator==(const small_vector& a, const small_vector& b)
+    {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+private:
+    T* inline_data() noexcept
+    {
+        return reinterpret_cast<T*>(m_inline);
+    }
+
+    const T* inline_data() const noexcept
+    {
+        return reinterpret_cast<const T*>(m_inline);
+    }
+
+    void grow(size_t capacity)
+    {
+        T* bigger = std::allocator<T>{}.allocate(capacity);
+#ifdef HFL_NO_EXCEPTIONS
+        uninitialized_relocate_n(m_data, m_size, bigger);
+#else
+        try
+        {
+            uninitialized_relocate_n(m_data, m_size, bigger);
+        }
+        catch (...)
+        {
+            std::allocator<T>{}.deallocate(bigger, capacity);
+            throw;
+        }
+#endif
+        release();
+        m_data = bigger;
+        m_capacity = capacity;
+    }
+
+    // args may refer to an element, so the new one is built before the old ones
+    // are relocated out from under it.
+    template<typename... Args>
+    T& grow_and_emplace_back(Args&&... args)
+    {
+        const size_t capacity = m_capacity * 2;
+        T* bigger = std::allocator<T>{}.allocate(capacity);
+        T* slot = nullptr;
+#ifdef HFL_NO_EXCEPTIONS
+        slot = std::construct_at(bigger + m_size, std::forward<Args>(args)...);
+        uninitialized_relocate_n(m_data, m_size, bigger);
+#else
+        try
+        {
+            slot = std::construct_at(bigger + m_size, std::forward<Args>(args)...);
+            uninitialized_relocate_n(m_data, m_size, bigger);
+        }
+        catch (...)
+        {
+            if (slot != nullptr)
+            {
+                std::destroy_at(slot);
+            }
+            std::allocator<T>{}.deallocate(bigger, capacity);
+            throw;
+        }
+#endif
+        release();
+        m_data = bigger;
+        m_capacity = capacity;
+        ++m_size;
+        return *slot;
+    }
+
+    // Frees the heap buffer, the elements must be gone already.
+    void release() noexcept
+    {
+        if (!is_inline())
+        {
+            std::allocator<T>{}.deallocate(m_data, m_capacity);
+            m_data = inline_data();
+            m_capacity = N;
+        }
+    }
+
+    // Takes the elements of other and leaves it empty.
+    void take(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (other.is_inline())
+        {
+            uninitialized_relocate_n(other.m_data, other.m_size, m_data);
+        }
+        else
+        {
+            m_data = std::exchange(other.m_data, other.inline_data());
+            m_capacity = std::exchange(other.m_capacity, N);
+        }
+        m_size = std::exchange(other.m_size, 0);
+    }
+
+    alignas(T) unsigned char m_inline[N * sizeof(T)];
+    T* m_data{inline_data()};
+    size_t m_size{0};
+    size_t m_capacity{N};
+};
+
+// Inline elements are pointed to by m_data, a byte copy would point back
+// into the source.
+template<typename T, size_t N>
+struct is_trivially_relocatable<small_vector<T, N>> : std::false_type
+{
+};
+
+} // namespace hfl
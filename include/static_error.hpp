@@ -0,0 +1,206 @@
+#pragma once
+#include "rs_storage.hpp"
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace hfl
+{
+
+template<typename... Args>
+class error_with;
+
+// Static description of one kind of error, define each once and refer to it:
+//
+//   inline constexpr hfl::error_descriptor key_not_found{"key_not_found", "key {} not found"};
+//
+//   hfl::rs_result<int, hfl::static_error> find(int key);      // err(key_not_found)
+//   hfl::rs_result<int, hfl::error_with<int>> find_with(int key); // err(key_not_found(key))
+//
+// The descriptor's address is its identity. Each {} in the format is replaced
+// by the next captured argument when a message is asked for.
+struct error_descriptor
+{
+    std::string_view m_name;
+    std::string_view m_format;
+
+    template<typename... Args>
+    constexpr auto operator()(Args&&... args) const& -> error_with<std::decay_t<Args>...>
+    {
+        return error_with<std::decay_t<Args>...>{*this, std::forward<Args>(args)...};
+    }
+
+    // A temporary has no lasting address to be identified by.
+    template<typename... Args>
+    void operator()(Args&&... args) const&& = delete;
+};
+
+template<typename T>
+void append_error_arg(std::string& out, const T& arg)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        out += arg ? "true" : "false";
+    }
+    else if constexpr (std::is_same_v<T, char>)
+    {
+        out += arg;
+    }
+    else if constexpr (std::is_arithmetic_v<T>)
+    {
+        char buf[64];
+        const auto res = std::to_chars(buf, buf + sizeof(buf), arg);
+        out.append(buf, res.ptr);
+    }
+    else
+    {
+        static_assert(std::is_convertible_v<const T&, std::string_view>,
+                      "error arguments are arithmetic values or convertible to std::string_view");
+        out += std::string_view{arg};
+    }
+}
+
+// Replaces each {} of format by the next argument, surplus placeholders stay.
+template<typename... Args>
+std::string format_error(std::string_view format, const Args&... args)
+{
+    std::string out;
+    out.reserve(format.size());
+    auto append_next = [&out, &format](const auto& arg) {
+        const size_t pos = format.find("{}");
+        if (pos == std::string_view::npos)
+        {
+            return;
+        }
+        out.append(format.substr(0, pos));
+        append_error_arg(out, arg);
+        format.remove_prefix(pos + 2);
+    };
+    (append_next(args), ...);
+    out.append(format);
+    return out;
+}
+
+// One word: a pointer to an interned error_descriptor. Building, copying and
+// comparing it never allocates, the message is only formatted on request.
+class static_error
+{
+public:
+    constexpr static_error(const error_descriptor& desc) noexcept : m_desc(&desc)
+    {
+    }
+
+    // Only descriptors with static storage have a stable identity.
+    static_error(const error_descriptor&&) = delete;
+
+    constexpr const error_descriptor& descriptor() const noexcept
+    {
+        return *m_desc;
+    }
+
+    constexpr std::string_view name() const noexcept
+    {
+        return m_desc->m_name;
+    }
+
+    constexpr bool is(const error_descriptor& desc) const noexcept
+    {
+        return m_desc == &desc;
+    }
+
+    std::string message() const
+    {
+        return std::string{m_desc->m_format};
+    }
+
+    friend constexpr bool operator==(static_error a, static_error b) noexcept
+    {
+        return a.m_desc == b.m_desc;
+    }
+
+    friend constexpr bool operator==(static_error a, const error_descriptor& desc) noexcept
+    {
+        return a.is(desc);
+    }
+
+private:
+    friend struct niche_traits<static_error>;
+
+    constexpr static_error() noexcept = default;
+
+    const error_descriptor* m_desc{nullptr};
+};
+
+// The descriptor plus the arguments of this occurrence, stored inline.
+template<typename... Args>
+class error_with
+{
+public:
+    template<typename... Us>
+    constexpr explicit error_with(const error_descriptor& desc, Us&&... args)
+        : m_desc(&desc), m_args(std::forward<Us>(args)...)
+    {
+    }
+
+    template<typename... Us>
+    explicit error_with(const error_descriptor&&, Us&&...) = delete;
+
+    constexpr const error_descriptor& descriptor() const noexcept
+    {
+        return *m_desc;
+    }
+
+    constexpr std::string_view name() const noexcept
+    {
+        return m_desc->m_name;
+    }
+
+    constexpr bool is(const error_descriptor& desc) const noexcept
+    {
+        return m_desc == &desc;
+    }
+
+    constexpr const std::tuple<Args...>& args() const noexcept
+    {
+        return m_args;
+    }
+
+    std::string message() const
+    {
+        return std::apply([this](const Args&... args) { return format_error(m_desc->m_format, args...); }, m_args);
+    }
+
+    // Drops the arguments, for callers that only care about the kind.
+    constexpr operator static_error() const noexcept
+    {
+        return static_error{*m_desc};
+    }
+
+private:
+    const error_descriptor* m_desc;
+    std::tuple<Args...> m_args;
+};
+
+// A static_error never holds a null descriptor, so rs_option<static_error> and
+// rs_result<static_error, Empty> need no discriminant.
+template<>
+struct niche_traits<static_error>
+{
+    static constexpr bool has_niche = true;
+
+    static constexpr static_error niche() noexcept
+    {
+        return static_error{};
+    }
+
+    static constexpr bool is_niche(const static_error& e) noexcept
+    {
+        return e.m_desc == nullptr;
+    }
+};
+
+} // namespace hfl
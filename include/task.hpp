@@ -0,0 +1,368 @@
+#pragma once
+#include "executor.hpp"
+#include "rs_result.hpp"
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace hfl
+{
+
+template<typename T, typename E>
+class task;
+
+template<typename T>
+struct is_task : std::false_type
+{
+};
+
+template<typename T, typename E>
+struct is_task<task<T, E>> : std::true_type
+{
+};
+
+template<typename T>
+constexpr bool is_task_v = is_task<std::remove_cvref_t<T>>::value;
+
+// The rs_result a continuation hands on, whether it returns one directly or
+// through a task.
+template<typename R>
+struct continuation_result
+{
+    using type = std::remove_cvref_t<R>;
+};
+
+template<typename T, typename E>
+struct continuation_result<task<T, E>>
+{
+    using type = rs_result<T, E>;
+};
+
+template<typename R>
+using continuation_ok_t = typename continuation_result<std::remove_cvref_t<R>>::type::raw_ok_type;
+
+template<typename T, typename E>
+class task_promise
+{
+public:
+    using value_type = rs_result<T, E>;
+
+    task<T, E> get_return_object() noexcept;
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    // Hands control straight to whoever awaits the task, so continuations run
+    // inline on the thread that completed it.
+    struct final_awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<task_promise> handle) const noexcept
+        {
+            return handle.promise().m_continuation;
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    final_awaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    template<typename U>
+        requires std::is_constructible_v<value_type, U&&>
+    void return_value(U&& val) noexcept(std::is_nothrow_constructible_v<value_type, U&&>)
+    {
+        m_result.emplace(std::forward<U>(val));
+    }
+
+    void unhandled_exception() noexcept
+    {
+#ifndef HFL_NO_EXCEPTIONS
+        m_exception = std::current_exception();
+#else
+        std::terminate();
+#endif
+    }
+
+    // co_await on an rs_result inside a task gives its payload or finishes the
+    // task with its error, like in rs_coroutine.hpp. Everything else is
+    // awaited as is.
+    template<typename U, typename F>
+        requires std::is_constructible_v<E, const F&>
+    auto await_transform(const rs_result<U, F>& res) noexcept
+    {
+        return early_return_awaiter<const rs_result<U, F>&, const typename rs_result<U, F>::raw_ok_type&>{res};
+    }
+
+    template<typename U, typename F>
+        requires std::is_constructible_v<E, const F&>
+    auto await_transform(rs_result<U, F>& res) noexcept
+    {
+        return early_return_awaiter<const rs_result<U, F>&, const typename rs_result<U, F>::raw_ok_type&>{res};
+    }
+
+    template<typename U, typename F>
+        requires std::is_constructible_v<E, F&&>
+    auto await_transform(rs_result<U, F>&& res) noexcept
+    {
+        return early_return_awaiter<rs_result<U, F>&&, typename rs_result<U, F>::raw_ok_type>{std::move(res)};
+    }
+
+    template<typename Awaitable>
+        requires(!is_rs_result_v<std::remove_cvref_t<Awaitable>>)
+    Awaitable&& await_transform(Awaitable&& awaitable) noexcept
+    {
+        return std::forward<Awaitable>(awaitable);
+    }
+
+private:
+    template<typename Operand, typename Payload>
+    class early_return_awaiter
+    {
+    public:
+        explicit early_return_awaiter(Operand res) noexcept : m_res(std::forward<Operand>(res))
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return m_res.is_ok();
+        }
+
+        // The task stays suspended here and is destroyed by its owner.
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<task_promise> handle)
+        {
+            auto& promise = handle.promise();
+            using err_type = typename value_type::err_type;
+            promise.m_result.emplace(err_type{std::forward<Operand>(m_res).unwrap_err_unchecked()});
+            return promise.m_continuation;
+        }
+
+        Payload await_resume()
+        {
+            return std::forward<Operand>(m_res).unwrap_unchecked();
+        }
+
+    private:
+        Operand m_res;
+    };
+
+    friend class task<T, E>;
+
+    std::optional<value_type> m_result;
+    std::coroutine_handle<> m_continuation{std::noop_coroutine()};
+#ifndef HFL_NO_EXCEPTIONS
+    std::exception_ptr m_exception;
+#endif
+};
+
+// Lazily started coroutine whose completion value is rs_result<T, E>. Nothing
+// runs until the task is awaited (or passed to sync_wait), co_await on the
+// task gives its rs_result. Use co_await ex.schedule() inside the task to move
+// it onto a work_stealing_executor.
+template<typename T, typename E>
+class task
+{
+public:
+    using promise_type = task_promise<T, E>;
+    using value_type = rs_result<T, E>;
+
+    task(task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr))
+    {
+    }
+
+    task& operator=(task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+
+    ~task()
+    {
+        destroy();
+    }
+
+    class awaiter
+    {
+    public:
+        explicit awaiter(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) const noexcept
+        {
+            m_handle.promise().m_continuation = continuation;
+            return m_handle;
+        }
+
+        value_type await_resume() const
+        {
+            auto& promise = m_handle.promise();
+#ifndef HFL_NO_EXCEPTIONS
+            if (promise.m_exception) [[unlikely]]
+            {
+                std::rethrow_exception(promise.m_exception);
+            }
+#endif
+            return std::move(*promise.m_result);
+        }
+
+    private:
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    awaiter operator co_await() && noexcept
+    {
+        return awaiter{m_handle};
+    }
+
+    // Continuations are coroutines awaiting this task, they run right after it
+    // completes on the same thread without blocking anyone.
+    template<typename Func>
+        requires std::is_invocable_v<Func&, T&&>
+    auto map(Func f) && -> task<std::invoke_result_t<Func&, T&&>, E>
+    {
+        return map_task(std::move(*this), std::move(f));
+    }
+
+    // f returns either rs_result<U, E> or task<U, E>.
+    template<typename Func>
+        requires std::is_invocable_v<Func&, T&&> and
+                 (is_rs_result_v<std::invoke_result_t<Func&, T&&>> or is_task_v<std::invoke_result_t<Func&, T&&>>)
+    auto and_then(Func f) && -> task<continuation_ok_t<std::invoke_result_t<Func&, T&&>>, E>
+    {
+        return and_then_task(std::move(*this), std::move(f));
+    }
+
+private:
+    friend class task_promise<T, E>;
+
+    explicit task(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle)
+    {
+    }
+
+    void destroy() noexcept
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+            m_handle = nullptr;
+        }
+    }
+
+    template<typename Func>
+    static auto map_task(task self, Func f) -> task<std::invoke_result_t<Func&, T&&>, E>
+    {
+        value_type res = co_await std::move(self);
+        co_return std::move(res).map(f);
+    }
+
+    template<typename Func>
+    static auto and_then_task(task self, Func f)
+        -> task<continuation_ok_t<std::invoke_result_t<Func&, T&&>>, E>
+    {
+        value_type res = co_await std::move(self);
+        if (res.is_err())
+        {
+            co_return typename value_type::err_type{std::move(res).unwrap_err_unchecked()};
+        }
+        if constexpr (is_task_v<std::invoke_result_t<Func&, T&&>>)
+        {
+            co_return co_await std::invoke(f, std::move(res).unwrap_unchecked());
+        }
+        else
+        {
+            co_return std::invoke(f, std::move(res).unwrap_unchecked());
+        }
+    }
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+template<typename T, typename E>
+task<T, E> task_promise<T, E>::get_return_object() noexcept
+{
+    return task<T, E>{std::coroutine_handle<task_promise>::from_promise(*this)};
+}
+
+template<typename T, typename E>
+struct sync_wait_state
+{
+    std::optional<rs_result<T, E>> m_result;
+#ifndef HFL_NO_EXCEPTIONS
+    std::exception_ptr m_exception;
+#endif
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_done{false};
+};
+
+template<typename T, typename E>
+detached_task sync_wait_driver(task<T, E> t, sync_wait_state<T, E>& state)
+{
+#ifndef HFL_NO_EXCEPTIONS
+    try
+    {
+        state.m_result.emplace(co_await std::move(t));
+    }
+    catch (...)
+    {
+        state.m_exception = std::current_exception();
+    }
+#else
+    state.m_result.emplace(co_await std::move(t));
+#endif
+    // Notify under the lock so the waiter can not return and destroy the
+    // state before this is done with it.
+    std::lock_guard lock{state.m_mutex};
+    state.m_done = true;
+    state.m_cv.notify_one();
+}
+
+// Runs the task and blocks the calling thread until it completes.
+template<typename T, typename E>
+rs_result<T, E> sync_wait(task<T, E> t)
+{
+    sync_wait_state<T, E> state;
+    sync_wait_driver(std::move(t), state);
+    {
+        std::unique_lock lock{state.m_mutex};
+        state.m_cv.wait(lock, [&state] { return state.m_done; });
+    }
+#ifndef HFL_NO_EXCEPTIONS
+    if (state.m_exception)
+    {
+        std::rethrow_exception(state.m_exception);
+    }
+#endif
+    return std::move(*state.m_result);
+}
+
+} // namespace hfl
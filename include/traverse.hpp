@@ -0,0 +1,344 @@
+#pragma once
+#include "executor.hpp"
+#include "rs_result.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hfl
+{
+
+template<typename Func, typename Range>
+concept traverse_func = std::ranges::random_access_range<Range> and std::ranges::sized_range<Range> and
+                        std::is_invocable_v<Func&, std::ranges::range_reference_t<Range>> and
+                        is_rs_result_v<std::invoke_result_t<Func&, std::ranges::range_reference_t<Range>>>;
+
+template<typename Func, typename Range>
+using traverse_stage_t = std::invoke_result_t<Func&, std::ranges::range_reference_t<Range>>;
+
+template<typename Func, typename Range>
+using traverse_result_t = rs_result<std::vector<typename traverse_stage_t<Func, Range>::raw_ok_type>,
+                                    typename traverse_stage_t<Func, Range>::raw_err_type>;
+
+// Preallocated output that workers fill at disjoint indices. vector<bool> packs
+// its elements, so it goes through the optional slots like types that have no
+// default constructor.
+template<typename T>
+class traverse_slots
+{
+    static constexpr bool direct = std::is_default_constructible_v<T> and !std::is_same_v<T, bool>;
+    using slot_type = std::conditional_t<direct, T, std::optional<T>>;
+
+public:
+    explicit traverse_slots(size_t n) : m_slots(n)
+    {
+    }
+
+    template<typename U>
+    void set(size_t index, U&& val)
+    {
+        m_slots[index] = std::forward<U>(val);
+    }
+
+    std::vector<T> take() &&
+    {
+        if constexpr (direct)
+        {
+            return std::move(m_slots);
+        }
+        else
+        {
+            std::vector<T> values;
+            values.reserve(m_slots.size());
+            for (auto& slot : m_slots)
+            {
+                values.push_back(std::move(*slot));
+            }
+            return values;
+        }
+    }
+
+private:
+    std::vector<slot_type> m_slots;
+};
+
+// Process-wide pool the parallel traversals run on, started on first use.
+inline work_stealing_executor& default_parallel_executor()
+{
+    static work_stealing_executor executor{};
+    return executor;
+}
+
+// Shared by the caller of parallel_chunks and the helpers it posted. Helpers
+// that only run once the caller is done (closed) return without touching
+// body, so the caller never waits for a helper that did not start in time and
+// a pool whose workers are all busy cannot deadlock it.
+template<typename Body>
+struct parallel_chunks_state
+{
+    parallel_chunks_state(Body& body, size_t n, size_t chunk_size, size_t chunk_count) noexcept
+        : m_body(&body), m_n(n), m_chunk_size(chunk_size), m_chunk_count(chunk_count)
+    {
+    }
+
+    void run_chunks() noexcept
+    {
+        while (!m_stopped.load(std::memory_order_relaxed))
+        {
+            const size_t chunk = m_next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= m_chunk_count)
+            {
+                return;
+            }
+            const size_t begin = chunk * m_chunk_size;
+            const size_t end = std::min(m_n, begin + m_chunk_size);
+#ifndef HFL_NO_EXCEPTIONS
+            try
+            {
+                if (!(*m_body)(begin, end))
+                {
+                    return;
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard lock{m_failure_mutex};
+                if (!m_failure)
+                {
+                    m_failure = std::current_exception();
+                }
+                m_stopped.store(true, std::memory_order_relaxed);
+                return;
+            }
+#else
+            if (!(*m_body)(begin, end))
+            {
+                return;
+            }
+#endif
+        }
+    }
+
+    void help() noexcept
+    {
+        m_active.fetch_add(1, std::memory_order_seq_cst);
+        if (!m_closed.load(std::memory_order_seq_cst))
+        {
+            run_chunks();
+        }
+        m_active.fetch_sub(1, std::memory_order_seq_cst);
+        m_active.notify_all();
+    }
+
+    // Turns away later helpers and waits for the running ones.
+    void close_and_wait() noexcept
+    {
+        m_closed.store(true, std::memory_order_seq_cst);
+        for (uint32_t active = m_active.load(std::memory_order_seq_cst); active != 0;
+             active = m_active.load(std::memory_order_seq_cst))
+        {
+            m_active.wait(active, std::memory_order_seq_cst);
+        }
+    }
+
+    Body* m_body;
+    size_t m_n;
+    size_t m_chunk_size;
+    size_t m_chunk_count;
+    std::atomic<size_t> m_next_chunk{0};
+    std::atomic<bool> m_stopped{false};
+    std::atomic<bool> m_closed{false};
+    std::atomic<uint32_t> m_active{0};
+#ifndef HFL_NO_EXCEPTIONS
+    std::exception_ptr m_failure;
+    std::mutex m_failure_mutex;
+#endif
+};
+
+// Splits [0, n) into chunks claimed in index order by up to thread_count
+// workers: the calling thread plus helpers posted to executor. body(begin, end)
+// returns false once later chunks are not needed anymore. The first exception
+// a worker throws stops the others and is rethrown here.
+template<typename Body>
+void parallel_chunks(size_t n, size_t thread_count, Body&& body,
+                     work_stealing_executor& executor = default_parallel_executor())
+{
+    if (n == 0)
+    {
+        return;
+    }
+    if (thread_count == 0)
+    {
+        thread_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    const size_t chunk_size = std::max<size_t>(1, n / (thread_count * 8));
+    const size_t chunk_count = (n + chunk_size - 1) / chunk_size;
+    thread_count = std::min(thread_count, chunk_count);
+
+    using state_type = parallel_chunks_state<std::remove_reference_t<Body>>;
+    auto state = std::make_shared<state_type>(body, n, chunk_size, chunk_count);
+#ifdef HFL_NO_EXCEPTIONS
+    for (size_t i = 1; i < thread_count; ++i)
+    {
+        executor.execute([state] { state->help(); });
+    }
+#else
+    try
+    {
+        for (size_t i = 1; i < thread_count; ++i)
+        {
+            executor.execute([state] { state->help(); });
+        }
+    }
+    catch (...)
+    {
+        state->close_and_wait();
+        throw;
+    }
+#endif
+    state->run_chunks();
+    state->close_and_wait();
+#ifndef HFL_NO_EXCEPTIONS
+    if (state->m_failure)
+    {
+        std::rethrow_exception(state->m_failure);
+    }
+#endif
+}
+
+// Applies f to every element and collects the payloads, or stops at the first
+// error.
+template<typename Range, typename Func>
+    requires traverse_func<Func, Range>
+auto traverse(Range&& range, Func&& f) -> traverse_result_t<Func, Range>
+{
+    using return_type = traverse_result_t<Func, Range>;
+    using values_type = typename return_type::raw_ok_type;
+    values_type values;
+    values.reserve(std::ranges::size(range));
+    for (auto&& item : range)
+    {
+        auto res = std::invoke(f, std::forward<decltype(item)>(item));
+        if (res.is_err()) [[unlikely]]
+        {
+            return return_type{typename return_type::err_type{std::move(res).unwrap_err_unchecked()}};
+        }
+        values.push_back(std::move(res).unwrap_unchecked());
+    }
+    return return_type{typename return_type::ok_type{std::move(values)}};
+}
+
+// traverse split between the caller and the workers of
+// default_parallel_executor, thread_count of them at most (0 picks
+// hardware_concurrency), no thread is started per call. The error returned is
+// always the one with the lowest index, the same traverse would give: once an
+// error is known, elements after it are skipped while the ones before it still
+// run. f is called concurrently.
+template<typename Range, typename Func>
+    requires traverse_func<Func, Range>
+auto parallel_traverse(Range&& range, Func&& f, size_t thread_count = 0) -> traverse_result_t<Func, Range>
+{
+    using return_type = traverse_result_t<Func, Range>;
+    using out_type = typename traverse_stage_t<Func, Range>::raw_ok_type;
+    using error_type = typename return_type::raw_err_type;
+
+    const size_t n = std::ranges::size(range);
+    auto first = std::ranges::begin(range);
+    traverse_slots<out_type> slots{n};
+    std::atomic<size_t> first_error{n};
+    std::optional<error_type> error;
+    std::mutex error_mutex;
+
+    parallel_chunks(n, thread_count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (i > first_error.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            auto res = std::invoke(f, first[i]);
+            if (res.is_ok()) [[likely]]
+            {
+                slots.set(i, std::move(res).unwrap_unchecked());
+                continue;
+            }
+            std::lock_guard lock{error_mutex};
+            if (i < first_error.load(std::memory_order_relaxed))
+            {
+                error.emplace(std::move(res).unwrap_err_unchecked());
+                first_error.store(i, std::memory_order_relaxed);
+            }
+            return false;
+        }
+        return true;
+    });
+
+    if (error.has_value())
+    {
+        return return_type{typename return_type::err_type{std::move(*error)}};
+    }
+    return return_type{typename return_type::ok_type{std::move(slots).take()}};
+}
+
+// Like parallel_traverse but runs every element and reports all errors with
+// their indices, sorted by index.
+template<typename Range, typename Func>
+    requires traverse_func<Func, Range>
+auto parallel_traverse_all(Range&& range, Func&& f, size_t thread_count = 0)
+    -> rs_result<std::vector<typename traverse_stage_t<Func, Range>::raw_ok_type>,
+                 std::vector<std::pair<size_t, typename traverse_stage_t<Func, Range>::raw_err_type>>>
+{
+    using out_type = typename traverse_stage_t<Func, Range>::raw_ok_type;
+    using error_entry = std::pair<size_t, typename traverse_stage_t<Func, Range>::raw_err_type>;
+    using return_type = rs_result<std::vector<out_type>, std::vector<error_entry>>;
+
+    const size_t n = std::ranges::size(range);
+    auto first = std::ranges::begin(range);
+    traverse_slots<out_type> slots{n};
+    std::vector<error_entry> errors;
+    std::mutex error_mutex;
+
+    parallel_chunks(n, thread_count, [&](size_t begin, size_t end) {
+        std::vector<error_entry> chunk_errors;
+        for (size_t i = begin; i < end; ++i)
+        {
+            auto res = std::invoke(f, first[i]);
+            if (res.is_ok()) [[likely]]
+            {
+                slots.set(i, std::move(res).unwrap_unchecked());
+            }
+            else
+            {
+                chunk_errors.emplace_back(i, std::move(res).unwrap_err_unchecked());
+            }
+        }
+        if (!chunk_errors.empty())
+        {
+            std::lock_guard lock{error_mutex};
+            std::move(chunk_errors.begin(), chunk_errors.end(), std::back_inserter(errors));
+        }
+        return true;
+    });
+
+    if (!errors.empty())
+    {
+        std::sort(errors.begin(), errors.end(),
+                  [](const error_entry& a, const error_entry& b) { return a.first < b.first; });
+        return return_type{typename return_type::err_type{std::move(errors)}};
+    }
+    return return_type{typename return_type::ok_type{std::move(slots).take()}};
+}
+
+} // namespace hfl
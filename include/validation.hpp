@@ -0,0 +1,237 @@
+#pragma once
+#include "rs_result.hpp"
+#include "small_vector.hpp"
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace hfl
+{
+
+template<typename E, size_t N>
+using error_list = small_vector<E, N>;
+
+// Like rs_result, but a failure carries every error that was found instead of
+// the first one. Up to N errors are stored inline.
+template<typename T, typename E, size_t N = 4>
+class validation
+{
+public:
+    using value_type = T;
+    using error_type = E;
+    using error_list_type = error_list<E, N>;
+
+    constexpr validation(ok<T>&& val) : m_result(std::move(val))
+    {
+    }
+
+    constexpr validation(const ok<T>& val) : m_result(val)
+    {
+    }
+
+    validation(err<E> e) : m_result(err<error_list_type>{error_list_type{}})
+    {
+        errors_mut().push_back(std::move(e.m_value));
+    }
+
+    // Builds the value in place from builder's conversion to T.
+    template<typename Builder>
+        requires std::is_convertible_v<Builder&&, T>
+    constexpr validation(std::in_place_t, Builder&& builder) : m_result(std::forward<Builder>(builder))
+    {
+    }
+
+    // errors must not be empty.
+    explicit validation(error_list_type errors) : m_result(err<error_list_type>{std::move(errors)})
+    {
+    }
+
+    constexpr bool is_valid() const noexcept
+    {
+        return m_result.is_ok();
+    }
+
+    constexpr bool is_invalid() const noexcept
+    {
+        return m_result.is_err();
+    }
+
+    constexpr const T& value() const&
+    {
+        return m_result.unwrap_ref();
+    }
+
+    constexpr T&& value() &&
+    {
+        return std::move(m_result).unwrap_ref();
+    }
+
+    const error_list_type& errors() const&
+    {
+        return m_result.unwrap_err_ref();
+    }
+
+    error_list_type&& errors() &&
+    {
+        return std::move(m_result).unwrap_err_ref();
+    }
+
+    rs_result<T, error_list_type> into_result() &&
+    {
+        return std::move(m_result);
+    }
+
+private:
+    error_list_type& errors_mut() noexcept
+    {
+        return m_result.unwrap_err_unchecked();
+    }
+
+    rs_result<T, error_list_type> m_result;
+};
+
+// What validate reads from one input: an rs_result<T, E> contributes its
+// error, a validation all of its errors.
+template<typename X>
+struct validation_input;
+
+template<typename T, typename E>
+struct validation_input<rs_result<T, E>>
+{
+    using value_type = T;
+    using error_type = E;
+
+    static constexpr bool is_ok(const rs_result<T, E>& x) noexcept
+    {
+        return x.is_ok();
+    }
+
+    template<typename X>
+    static constexpr decltype(auto) value(X&& x) noexcept
+    {
+        return std::forward<X>(x).unwrap_unchecked();
+    }
+
+    template<typename X, size_t N>
+    static void append_errors(X&& x, error_list<E, N>& errors)
+    {
+        if (x.is_err())
+        {
+            errors.emplace_back(std::forward<X>(x).unwrap_err_unchecked());
+        }
+    }
+};
+
+template<typename T, typename E, size_t M>
+struct validation_input<validation<T, E, M>>
+{
+    using value_type = T;
+    using error_type = E;
+
+    static constexpr bool is_ok(const validation<T, E, M>& x) noexcept
+    {
+        return x.is_valid();
+    }
+
+    template<typename X>
+    static constexpr decltype(auto) value(X&& x) noexcept
+    {
+        return std::forward<X>(x).value();
+    }
+
+    template<typename X, size_t N>
+    static void append_errors(X&& x, error_list<E, N>& errors)
+    {
+        if (x.is_valid())
+        {
+            return;
+        }
+        for (auto&& e : std::forward<X>(x).errors())
+        {
+            if constexpr (std::is_lvalue_reference_v<X>)
+            {
+                errors.push_back(e);
+            }
+            else
+            {
+                errors.push_back(std::move(e));
+            }
+        }
+    }
+};
+
+template<typename X>
+using validation_input_traits = validation_input<std::remove_cvref_t<X>>;
+
+template<typename X>
+concept validation_input_type = requires { sizeof(validation_input<std::remove_cvref_t<X>>); };
+
+template<typename X>
+using validation_input_error_t = typename validation_input_traits<X>::error_type;
+
+template<typename Input, typename... Inputs>
+constexpr bool same_validation_error_v =
+    (std::is_same_v<validation_input_error_t<Input>, validation_input_error_t<Inputs>> and ...);
+
+template<typename X>
+using validation_input_value_t = decltype(validation_input_traits<X>::value(std::declval<X>()));
+
+template<typename Func, typename... Inputs>
+concept validate_func = (validation_input_type<Inputs> and ...) and
+                        std::is_invocable_v<Func, validation_input_value_t<Inputs>...>;
+
+template<typename Func, typename... Inputs>
+using validate_result_t = std::invoke_result_t<Func, validation_input_value_t<Inputs>...>;
+
+// Applicative over any number of independently computed inputs: f gets every
+// payload when all inputs are ok, otherwise the errors of all failed inputs
+// are collected in argument order. No input depends on another, so they can
+// as well be computed in parallel before the call.
+//
+//   auto p = hfl::validate([](std::string name, int age) { return person{name, age}; },
+//                          check_name(raw.name), check_age(raw.age));
+template<size_t N = 4, typename Func, typename Input, typename... Inputs>
+    requires validate_func<Func, Input, Inputs...> and same_validation_error_v<Input, Inputs...>
+auto validate(Func&& f, Input&& input, Inputs&&... inputs)
+    -> validation<validate_result_t<Func, Input, Inputs...>, validation_input_error_t<Input>, N>
+{
+    using return_type = validation<validate_result_t<Func, Input, Inputs...>, validation_input_error_t<Input>, N>;
+    using value_type = typename return_type::value_type;
+
+    const bool all_ok =
+        (validation_input_traits<Input>::is_ok(input) and ... and validation_input_traits<Inputs>::is_ok(inputs));
+    if (all_ok) [[likely]]
+    {
+        auto build = [&]() -> value_type {
+            return std::invoke(std::forward<Func>(f), validation_input_traits<Input>::value(std::forward<Input>(input)),
+                               validation_input_traits<Inputs>::value(std::forward<Inputs>(inputs))...);
+        };
+        return return_type{std::in_place, deferred_value<value_type, decltype(build)&>{build}};
+    }
+
+    typename return_type::error_list_type errors;
+    validation_input_traits<Input>::append_errors(std::forward<Input>(input), errors);
+    (validation_input_traits<Inputs>::append_errors(std::forward<Inputs>(inputs), errors), ...);
+    return return_type{std::move(errors)};
+}
+
+template<typename T>
+struct brace_construct
+{
+    template<typename... Args>
+    constexpr T operator()(Args&&... args) const
+    {
+        return T{std::forward<Args>(args)...};
+    }
+};
+
+// validate that builds T{payloads...} straight into the result, for
+// aggregates with one checked input per field.
+template<typename T, size_t N = 4, typename... Inputs>
+auto validate_into(Inputs&&... inputs) -> decltype(validate<N>(brace_construct<T>{}, std::forward<Inputs>(inputs)...))
+{
+    return validate<N>(brace_construct<T>{}, std::forward<Inputs>(inputs)...);
+}
+
+} // namespace hfl
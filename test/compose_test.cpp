@@ -0,0 +1,146 @@
+#include "compose.hpp"
+#include "curried.hpp"
+#include <array>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+
+static int add_one(int v)
+{
+    return v + 1;
+}
+
+constexpr int times_by_two(int v)
+{
+    return v * 2;
+}
+
+TEST(compose_test, compose_left_to_right)
+{
+    auto f = hfl::compose(add_one, [](int v) { return v * 10; });
+    EXPECT_EQ(30, f(2));
+}
+
+TEST(compose_test, compose_changes_type)
+{
+    auto f = hfl::compose([](int v) { return v + 1; }, [](int v) { return std::to_string(v); },
+                          [](const std::string& s) { return s + "!"; });
+    EXPECT_EQ("3!", f(2));
+}
+
+TEST(compose_test, compose_with_curried_partial)
+{
+    hfl::curried mul([](int a, int b) { return a * b; });
+    auto f = hfl::compose(mul(3), add_one);
+    EXPECT_EQ(13, f(4));
+}
+
+static_assert(hfl::compose(times_by_two, times_by_two)(3) == 12);
+static_assert(hfl::compose([](int v) { return v + 1; }, times_by_two)(3) == 8);
+
+constexpr auto scale_then_offset = hfl::compose(hfl::curried([](int f, int v) { return f * v; })(3),
+                                                hfl::curried([](int o, int v) { return o + v; })(1));
+static_assert(scale_then_offset(4) == 13);
+
+consteval std::array<int, 5> make_table()
+{
+    std::array<int, 5> table{};
+    constexpr auto f = hfl::compose(hfl::bind_front([](int a, int b) { return a * b; }, 3), times_by_two);
+    for (int i = 0; i < 5; ++i)
+    {
+        table[i] = f(i);
+    }
+    return table;
+}
+
+TEST(compose_test, compose_compile_time_table)
+{
+    constexpr auto table = make_table();
+    static_assert(table[4] == 24);
+    EXPECT_EQ(18, table[3]);
+}
+
+static hfl::rs_result<int, std::string> parse_digit(const std::string& s)
+{
+    if (s.size() == 1 && s[0] >= '0' && s[0] <= '9')
+    {
+        return hfl::rs_result<int, std::string>{hfl::ok<int>{s[0] - '0'}};
+    }
+    return hfl::rs_result<int, std::string>{hfl::err<std::string>{"not a digit"}};
+}
+
+static hfl::rs_result<int, std::string> half_even(int v)
+{
+    if (v % 2 == 0)
+    {
+        return hfl::rs_result<int, std::string>{hfl::ok<int>{v / 2}};
+    }
+    return hfl::rs_result<int, std::string>{hfl::err<std::string>{"odd"}};
+}
+
+TEST(compose_test, compose_operator_chain)
+{
+    using namespace hfl;
+    auto inc = [](int v) { return v + 1; };
+    auto dec = [](int v) { return v - 1; };
+    auto f = inc >> times_by_two >> dec;
+    static_assert(std::is_same_v<decltype(f), hfl::composed<decltype(inc), int (*)(int), decltype(dec)>>);
+    EXPECT_EQ(5, f(2));
+}
+
+TEST(compose_test, compose_operator_on_composed)
+{
+    auto f = hfl::compose(add_one) >> times_by_two >> add_one;
+    static_assert(std::is_same_v<decltype(f), hfl::composed<int (*)(int), int (*)(int), int (*)(int)>>);
+    EXPECT_EQ(7, f(2));
+}
+
+TEST(compose_test, compose_short_circuit_rs_result)
+{
+    auto f = hfl::compose(parse_digit, half_even, [](int v) { return v * 1.5; });
+    auto r1 = f("8");
+    static_assert(std::is_same_v<decltype(r1), hfl::rs_result<double, std::string>>);
+    EXPECT_EQ(6.0, r1.unwrap());
+
+    int called = 0;
+    auto g = hfl::compose(parse_digit, half_even, [&called](int v) {
+        ++called;
+        return v;
+    });
+    auto r2 = g("x");
+    EXPECT_EQ("not a digit", r2.unwrap_err());
+    auto r3 = g("3");
+    EXPECT_EQ("odd", r3.unwrap_err());
+    EXPECT_EQ(0, called);
+}
+
+TEST(compose_test, compose_short_circuit_optional)
+{
+    auto f = hfl::compose([](int v) -> std::optional<int> { return v > 0 ? std::optional<int>{v} : std::nullopt; },
+                          [](int v) { return v + 1; });
+    static_assert(std::is_same_v<decltype(f(1)), std::optional<int>>);
+    EXPECT_EQ(3, f(2).value());
+    EXPECT_EQ(false, f(-2).has_value());
+}
+
+TEST(compose_test, compose_short_circuit_result)
+{
+    auto f = hfl::compose(
+        [](int v) -> hfl::result<int> {
+            if (v < 0)
+            {
+                return std::make_error_code(std::errc::invalid_argument);
+            }
+            return v;
+        },
+        [](int v) { return v * 3; });
+    EXPECT_EQ(6, f(2).value());
+    EXPECT_EQ(false, f(-1).has_value());
+}
+
+TEST(compose_test, compose_whole_value_stage_is_not_unwrapped)
+{
+    auto f = hfl::compose(half_even, [](const hfl::rs_result<int, std::string>& r) { return r.is_ok(); });
+    EXPECT_EQ(true, f(4));
+    EXPECT_EQ(false, f(3));
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+// Payload that counts its copies and moves, for tests that check how often
+// a combinator or conversion copies. Call reset() before the code under test.
+struct copy_counter
+{
+    copy_counter(int v) : m_value(v) {}
+    copy_counter(const copy_counter& v) : m_value(v.m_value)
+    {
+        ++copies;
+    }
+    copy_counter(copy_counter&& v) noexcept : m_value(v.m_value)
+    {
+        ++moves;
+    }
+    copy_counter& operator=(const copy_counter& v)
+    {
+        m_value = v.m_value;
+        ++copies;
+        return *this;
+    }
+    copy_counter& operator=(copy_counter&& v) noexcept
+    {
+        m_value = v.m_value;
+        ++moves;
+        return *this;
+    }
+    bool operator==(const copy_counter& other) const
+    {
+        return m_value == other.m_value;
+    }
+
+    static void reset()
+    {
+        copies = 0;
+        moves = 0;
+    }
+
+    int m_value;
+    static inline int copies = 0;
+    static inline int moves = 0;
+};
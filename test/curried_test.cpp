@@ -1,6 +1,10 @@
 #include "curried.hpp"
 #include "timer.hpp"
 #include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 static int return_int(int b)
 {
@@ -28,4 +32,193 @@ TEST(curried_test, lambda_invoke_sum_int_int)
     hfl::curried<int(int, int)> cur([](int a, int b){return a + b;});
     auto res = cur(2)(3);
     EXPECT_EQ(5, res);
-}
\ No newline at end of file
+}
+
+TEST(curried_test, deduced_lambda_keeps_concrete_type)
+{
+    int offset = 1;
+    auto add = [offset](int a, int b, int c) { return a + b + c + offset; };
+    hfl::curried cur(add);
+    static_assert(std::is_same_v<decltype(cur), hfl::curried<int(int, int, int), decltype(add)>>);
+    auto res = cur(2)(3)(4);
+    EXPECT_EQ(10, res);
+}
+
+TEST(curried_test, deduced_function_pointer)
+{
+    hfl::curried cur(return_int);
+    static_assert(std::is_same_v<decltype(cur), hfl::curried<int(int), int (*)(int)>>);
+    EXPECT_EQ(3, cur(3));
+}
+
+TEST(curried_test, partial_application_is_reusable)
+{
+    hfl::curried cur([](int a, int b, int c) { return a * 100 + b * 10 + c; });
+    auto prefix = cur(1);
+    auto prefix2 = prefix(2);
+    EXPECT_EQ(123, prefix2(3));
+    EXPECT_EQ(124, prefix2(4));
+    EXPECT_EQ(156, prefix(5)(6));
+    EXPECT_EQ(789, cur(7)(8)(9));
+    EXPECT_EQ(123, prefix2(3));
+}
+
+TEST(curried_test, partial_application_outlives_curried)
+{
+    auto make_prefix = [] {
+        hfl::curried<int(int, int)> cur([](int a, int b) { return a - b; });
+        return cur(10);
+    };
+    auto prefix = make_prefix();
+    EXPECT_EQ(7, prefix(3));
+    EXPECT_EQ(1, prefix(9));
+}
+
+TEST(curried_test, partial_application_shared_between_threads)
+{
+    hfl::curried cur([](long base, long scale, long v) { return base + scale * v; });
+    const auto prefix = cur(1000)(2);
+    constexpr long thread_count = 4;
+    constexpr long loop_count = 10000;
+    std::vector<long> sums(thread_count, 0);
+    std::vector<std::thread> threads;
+    for (long t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&prefix, &sums, t] {
+            for (long i = 0; i < loop_count; ++i)
+            {
+                sums[t] += prefix(i);
+            }
+        });
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    const long expected = 1000 * loop_count + 2 * (loop_count * (loop_count - 1) / 2);
+    for (auto sum : sums)
+    {
+        EXPECT_EQ(expected, sum);
+    }
+}
+
+struct copy_counter
+{
+    copy_counter() = default;
+    copy_counter(const copy_counter& other) : m_copies(other.m_copies + 1), m_moves(other.m_moves)
+    {
+    }
+    copy_counter(copy_counter&& other) noexcept : m_copies(other.m_copies), m_moves(other.m_moves + 1)
+    {
+    }
+    int m_copies{0};
+    int m_moves{0};
+};
+
+TEST(curried_test, rvalue_chain_moves_arguments)
+{
+    hfl::curried cur([](copy_counter a, const copy_counter& b, int) { return a.m_copies + b.m_copies; });
+    auto res = cur(copy_counter{})(copy_counter{})(1);
+    EXPECT_EQ(0, res);
+}
+
+TEST(curried_test, lvalue_partial_copies_bound_arguments)
+{
+    hfl::curried cur([](const copy_counter& a, int) { return a.m_copies; });
+    auto prefix = cur(copy_counter{});
+    EXPECT_EQ(0, std::move(prefix)(1));
+    auto prefix2 = cur(copy_counter{});
+    EXPECT_EQ(0, prefix2(1));
+    EXPECT_EQ(0, prefix2(2));
+}
+
+TEST(curried_test, move_only_argument)
+{
+    hfl::curried cur([](std::unique_ptr<int> p, int v) { return *p + v; });
+    auto res = cur(std::make_unique<int>(40))(2);
+    EXPECT_EQ(42, res);
+
+    auto prefix = cur(std::make_unique<int>(1));
+    EXPECT_EQ(3, std::move(prefix)(2));
+}
+
+TEST(curried_test, move_only_callable)
+{
+    auto owned = std::make_unique<int>(5);
+    hfl::curried cur([p = std::move(owned)](int a, int b) { return *p + a + b; });
+    EXPECT_EQ(8, std::move(cur)(1)(2));
+}
+
+TEST(curried_test, lvalue_reference_parameter)
+{
+    hfl::curried cur([](int& out, int v) { out = v; });
+    int target = 0;
+    auto set_target = cur(target);
+    set_target(3);
+    EXPECT_EQ(3, target);
+    set_target(7);
+    EXPECT_EQ(7, target);
+}
+
+TEST(curried_test, rvalue_reference_parameter)
+{
+    hfl::curried cur([](std::string&& s, const std::string& tail) { return std::move(s) + tail; });
+    std::string head = "ab";
+    auto res = cur(std::move(head))("c");
+    EXPECT_EQ("abc", res);
+}
+
+TEST(curried_test, multiple_arguments_per_call)
+{
+    hfl::curried cur([](int a, int b, int c, int d) { return a * 1000 + b * 100 + c * 10 + d; });
+    EXPECT_EQ(1234, cur(1, 2, 3, 4));
+    EXPECT_EQ(1234, cur(1, 2)(3, 4));
+    EXPECT_EQ(1234, cur(1)(2, 3)(4));
+    EXPECT_EQ(1234, cur(1, 2, 3)(4));
+    auto prefix = cur(1, 2);
+    static_assert(std::is_same_v<decltype(prefix), decltype(cur(1)(2))>);
+    EXPECT_EQ(1256, prefix(5, 6));
+}
+
+TEST(curried_test, bind_front_prefix)
+{
+    auto prefix = hfl::bind_front([](const std::string& a, const std::string& b, int n) { return a + b + std::to_string(n); },
+                                  std::string{"x"}, std::string{"y"});
+    EXPECT_EQ("xy1", prefix(1));
+    EXPECT_EQ("xy2", prefix(2));
+
+    auto add = [](int a, int b, int c) { return a + b + c; };
+    hfl::curried cur(add);
+    static_assert(std::is_same_v<decltype(hfl::bind_front(add, 1)), decltype(cur(1))>);
+    EXPECT_EQ(6, hfl::bind_front(add, 1, 2)(3));
+}
+
+constexpr int sum3(int a, int b, int c)
+{
+    return a + b + c;
+}
+
+static_assert(hfl::curried(sum3)(1)(2)(3) == 6);
+static_assert(hfl::curried(sum3)(1, 2, 3) == 6);
+static_assert(hfl::bind_front(sum3, 1, 2)(3) == 6);
+
+constexpr auto constexpr_prefix = hfl::curried([](int a, int b) { return a * 10 + b; })(4);
+static_assert(constexpr_prefix(2) == 42);
+static_assert(constexpr_prefix(3) == 43);
+
+consteval int consteval_curried_ref()
+{
+    int out = 0;
+    hfl::curried cur([](int& target, int v) { target += v; });
+    auto add_to_out = cur(out);
+    add_to_out(3);
+    add_to_out(4);
+    return out;
+}
+
+TEST(curried_test, constant_evaluation)
+{
+    static_assert(consteval_curried_ref() == 7);
+    constexpr auto res = hfl::curried(sum3)(4)(5, 6);
+    EXPECT_EQ(15, res);
+}
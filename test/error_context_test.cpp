@@ -0,0 +1,67 @@
+#include "error_context.hpp"
+#include "rs_result.hpp"
+#include "static_error.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+inline constexpr hfl::error_descriptor file_missing{"file_missing", "file {} is missing"};
+
+using load_error = hfl::error_with<const char*>;
+
+static hfl::rs_result<int, load_error> read_file(const char* path)
+{
+    return hfl::rs_result<int, load_error>{hfl::err<load_error>{file_missing(path)}};
+}
+
+static hfl::rs_result<int, hfl::context_error<load_error>> load_config()
+{
+    return read_file("app.cfg").map_err(hfl::add_context("while loading config"));
+}
+
+static hfl::rs_result<int, hfl::context_error<load_error>> start_server()
+{
+    return load_config().map_err(hfl::add_context("while starting server"));
+}
+
+TEST(error_context_test, context_chain_renders_innermost_first)
+{
+    auto e = start_server().unwrap_err();
+    EXPECT_EQ(2, e.depth());
+    EXPECT_EQ(true, e.error().is(file_missing));
+    EXPECT_EQ("file app.cfg is missing\n  while loading config\n  while starting server", e.render(false));
+
+    const std::string with_locations = e.render();
+    EXPECT_NE(std::string::npos, with_locations.find("while loading config (" __FILE__ ":"));
+    EXPECT_NE(std::string::npos, with_locations.find("while starting server (" __FILE__ ":"));
+}
+
+TEST(error_context_test, context_shares_tails_and_leaves_source_untouched)
+{
+    const hfl::context_error<std::string> base = hfl::context_error<std::string>{"boom"}.context("in a");
+    auto b = base.context("in b");
+    auto c = base.context("in c");
+    EXPECT_EQ(1, base.depth());
+    EXPECT_EQ(b.head()->m_next, c.head()->m_next);
+    EXPECT_EQ("boom\n  in a\n  in b", b.render(false));
+    EXPECT_EQ("boom\n  in a\n  in c", c.render(false));
+    EXPECT_EQ("boom", hfl::context_error<std::string>{"boom"}.render());
+}
+
+TEST(error_context_test, context_allocates_from_the_current_arena)
+{
+    hfl::context_arena arena;
+    {
+        hfl::context_arena_scope scope{arena};
+        auto e = hfl::context_error<int>{7};
+        for (int i = 0; i < 1000; ++i)
+        {
+            e = std::move(e).context("retrying");
+        }
+        EXPECT_EQ(1000, e.depth());
+        EXPECT_EQ(1000, arena.node_count());
+        EXPECT_EQ(&arena, &hfl::context_arena::current());
+    }
+    EXPECT_NE(&arena, &hfl::context_arena::current());
+    arena.reset();
+    EXPECT_EQ(0, arena.node_count());
+}
@@ -0,0 +1,187 @@
+#include "curried.hpp"
+#include "function.hpp"
+#include "function_ref.hpp"
+#include "optional_function.hpp"
+#include "result_function.hpp"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <string>
+
+static std::atomic<std::size_t> allocation_count{0};
+
+void* operator new(std::size_t size)
+{
+    ++allocation_count;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+static int add_one(int v)
+{
+    return v + 1;
+}
+
+TEST(function_test, empty_function)
+{
+    hfl::function<int(int)> f;
+    EXPECT_EQ(false, static_cast<bool>(f));
+    EXPECT_THROW(f(1), std::bad_function_call);
+    hfl::function<int(int)> g{static_cast<int (*)(int)>(nullptr)};
+    EXPECT_EQ(false, static_cast<bool>(g));
+}
+
+TEST(function_test, invoke_function_pointer_and_lambda)
+{
+    hfl::function<int(int)> f{add_one};
+    EXPECT_EQ(3, f(2));
+    int offset = 10;
+    f = [offset](int v) { return v + offset; };
+    EXPECT_EQ(12, f(2));
+    f = nullptr;
+    EXPECT_EQ(false, static_cast<bool>(f));
+}
+
+TEST(function_test, void_signature_discards_result)
+{
+    int calls = 0;
+    hfl::function<void()> f{[&calls]() { return ++calls; }};
+    f();
+    hfl::function<void()> g{[&calls, big = std::array<char, 64>{}]() { return ++calls + big[0]; }};
+    g();
+    hfl::function<void(int)> h{add_one};
+    h(1);
+    EXPECT_EQ(2, calls);
+}
+
+TEST(function_test, move_only_callable)
+{
+    hfl::function<int()> f{[p = std::make_unique<int>(42)] { return *p; }};
+    hfl::function<int()> g{std::move(f)};
+    EXPECT_EQ(false, static_cast<bool>(f));
+    EXPECT_EQ(42, g());
+    f = std::move(g);
+    EXPECT_EQ(42, f());
+}
+
+TEST(function_test, noexcept_signature)
+{
+    hfl::function<int(int) noexcept> f{[](int v) noexcept { return v * 2; }};
+    static_assert(noexcept(f(1)));
+    static_assert(!noexcept(std::declval<hfl::function<int(int)>&>()(1)));
+    static_assert(!std::is_constructible_v<hfl::function<int(int) noexcept>, int (*)(int)>);
+    EXPECT_EQ(4, f(2));
+}
+
+TEST(function_test, inline_callable_does_not_allocate)
+{
+    std::array<char, hfl::function_default_capacity - sizeof(int)> pad{};
+    int offset = 3;
+    const auto before = allocation_count.load();
+    hfl::function<int(int)> f{[pad, offset](int v) { return v + offset + pad[0]; }};
+    hfl::function<int(int)> g{std::move(f)};
+    int sum = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        sum += g(i);
+    }
+    EXPECT_EQ(before, allocation_count.load());
+    EXPECT_EQ(499500 + 3000, sum);
+}
+
+TEST(function_test, big_callable_goes_to_heap)
+{
+    std::array<char, 128> big{};
+    big[0] = 1;
+    const auto before = allocation_count.load();
+    hfl::function<int()> f{[big] { return big[0]; }};
+    EXPECT_EQ(before + 1, allocation_count.load());
+    hfl::function<int()> g{std::move(f)};
+    EXPECT_EQ(before + 1, allocation_count.load());
+    EXPECT_EQ(1, g());
+}
+
+TEST(function_test, inplace_function_custom_capacity)
+{
+    std::array<char, 100> big{};
+    big[0] = 7;
+    const auto before = allocation_count.load();
+    hfl::inplace_function<int(), 128> f{[big] { return big[0]; }};
+    EXPECT_EQ(7, f());
+    EXPECT_EQ(before, allocation_count.load());
+    static_assert(std::is_constructible_v<hfl::inplace_function<int(), 128>, decltype([big] { return big[0]; })>);
+}
+
+TEST(function_test, accepted_by_curried)
+{
+    hfl::curried<int(int, int), hfl::function<int(int, int)>> cur([](int a, int b) { return a - b; });
+    const auto before = allocation_count.load();
+    EXPECT_EQ(3, std::move(cur)(5)(2));
+    EXPECT_EQ(before, allocation_count.load());
+}
+
+TEST(function_test, accepted_by_applicative)
+{
+    std::optional<int> one{1};
+    std::optional<hfl::function<int(int)>> add{hfl::function<int(int)>{add_one}};
+    EXPECT_EQ(2, hfl::applicative(one, add).value());
+
+    hfl::result<int> two{2};
+    hfl::result<hfl::function<int(int)>> add_res{hfl::function<int(int)>{add_one}};
+    EXPECT_EQ(3, hfl::applicative(two, add_res).value());
+}
+
+TEST(function_test, function_ref_to_function_and_lambda)
+{
+    hfl::function_ref<int(int)> r1{add_one};
+    EXPECT_EQ(2, r1(1));
+    int calls = 0;
+    auto counting = [&calls](int v) {
+        ++calls;
+        return v * 3;
+    };
+    hfl::function_ref<long(int)> r2{counting};
+    EXPECT_EQ(9, r2(3));
+    hfl::function_ref<long(int)> r3{r2};
+    EXPECT_EQ(12, r3(4));
+    EXPECT_EQ(2, calls);
+    static_assert(sizeof(r1) == 2 * sizeof(void*));
+}
+
+TEST(function_test, function_ref_void_signature_discards_result)
+{
+    int calls = 0;
+    auto counting = [&calls](int v) { return calls += v; };
+    hfl::function_ref<void(int)> r1{counting};
+    r1(2);
+    hfl::function_ref<void(int)> r2{add_one};
+    r2(1);
+    EXPECT_EQ(2, calls);
+}
+
+TEST(function_test, function_ref_noexcept_and_no_allocation)
+{
+    auto twice = [](int v) noexcept { return v * 2; };
+    const auto before = allocation_count.load();
+    hfl::function_ref<int(int) noexcept> r{twice};
+    static_assert(noexcept(r(1)));
+    static_assert(!std::is_constructible_v<hfl::function_ref<int(int) noexcept>, int (&)(int)>);
+    EXPECT_EQ(8, r(4));
+    EXPECT_EQ(before, allocation_count.load());
+}
@@ -0,0 +1,47 @@
+#include "function.hpp"
+#include "rs_option.hpp"
+#include "rs_result.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <string>
+
+#ifndef HFL_NO_EXCEPTIONS
+#error "no_exceptions_test must be built with exceptions disabled"
+#endif
+
+static void exit_with_kind(hfl::unwrap_failure_kind kind, const char* message) noexcept
+{
+    std::fprintf(stderr, "unwrap failure: %s\n", message);
+    std::_Exit(10 + static_cast<int>(kind));
+}
+
+TEST(no_exceptions_test, unwrap_success)
+{
+    hfl::rs_result<int, std::string> a{hfl::ok{1}};
+    hfl::rs_option<int> b{hfl::some{2}};
+    EXPECT_EQ(1, a.unwrap());
+    EXPECT_EQ(1, a.expect("ok"));
+    EXPECT_EQ(2, b.unwrap());
+}
+
+TEST(no_exceptions_test, unwrap_err_calls_handler)
+{
+    hfl::set_unwrap_failure_handler(&exit_with_kind);
+    hfl::rs_result<int, std::string> a{hfl::err<std::string>{"e"}};
+    EXPECT_EXIT(a.unwrap(), testing::ExitedWithCode(10), "unwrap called on an err");
+    EXPECT_EXIT(a.expect("custom message"), testing::ExitedWithCode(10), "custom message");
+    hfl::rs_result<int, std::string> b{hfl::ok{1}};
+    EXPECT_EXIT(b.unwrap_err(), testing::ExitedWithCode(11), "unwrap_err called on an ok");
+    hfl::rs_option<int> c{hfl::none{}};
+    EXPECT_EXIT(c.unwrap(), testing::ExitedWithCode(12), "unwrap called on a none");
+    hfl::set_unwrap_failure_handler(nullptr);
+}
+
+TEST(no_exceptions_test, unwrap_without_handler_aborts)
+{
+    hfl::rs_option<int> c{hfl::none{}};
+    EXPECT_DEATH(c.unwrap(), "");
+    hfl::function<int()> f;
+    EXPECT_DEATH(f(), "");
+}
@@ -0,0 +1,97 @@
+#include "relocatable.hpp"
+#include "rs_option.hpp"
+#include "rs_result.hpp"
+#include "static_error.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+
+namespace
+{
+
+// Owns a heap int, has a real move constructor, but no pointer into itself.
+struct owned_int
+{
+    static inline int moves = 0;
+
+    explicit owned_int(int v) : m_value(std::make_unique<int>(v))
+    {
+    }
+
+    owned_int(owned_int&& other) noexcept : m_value(std::move(other.m_value))
+    {
+        ++moves;
+    }
+
+    std::unique_ptr<int> m_value;
+};
+
+} // namespace
+
+template<>
+struct hfl::is_trivially_relocatable<owned_int> : std::true_type
+{
+};
+
+static_assert(std::is_trivially_copyable_v<hfl::rs_result<int, int>>);
+static_assert(std::is_trivially_copyable_v<hfl::rs_result<double, std::errc>>);
+static_assert(std::is_trivially_copyable_v<hfl::rs_result<int*, std::error_code>>);
+static_assert(std::is_trivially_copyable_v<hfl::rs_result<int, hfl::static_error>>);
+static_assert(std::is_trivially_copyable_v<hfl::rs_result<int, hfl::none>>);
+static_assert(std::is_trivially_copyable_v<hfl::rs_option<int>>);
+static_assert(std::is_trivially_copyable_v<hfl::rs_option<int*>>);
+static_assert(std::is_trivially_copyable_v<hfl::rs_option<hfl::static_error>>);
+static_assert(!std::is_trivially_copyable_v<hfl::rs_result<std::string, int>>);
+
+static_assert(hfl::is_trivially_relocatable_v<hfl::rs_result<int, int>>);
+static_assert(hfl::is_trivially_relocatable_v<hfl::rs_result<owned_int, int>>);
+static_assert(hfl::is_trivially_relocatable_v<hfl::rs_option<owned_int>>);
+static_assert(!hfl::is_trivially_relocatable_v<hfl::rs_result<std::string, int>>);
+static_assert(!hfl::is_trivially_relocatable_v<hfl::rs_result<owned_int, std::string>>);
+
+TEST(relocatable_test, trivially_relocatable_results_are_memcpyd)
+{
+    using result = hfl::rs_result<owned_int, int>;
+    alignas(result) unsigned char from_buf[sizeof(result) * 4];
+    alignas(result) unsigned char to_buf[sizeof(result) * 4];
+    auto* from = reinterpret_cast<result*>(from_buf);
+    auto* to = reinterpret_cast<result*>(to_buf);
+    for (int i = 0; i < 4; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            std::construct_at(from + i, hfl::ok{owned_int{i}});
+        }
+        else
+        {
+            std::construct_at(from + i, hfl::err{i});
+        }
+    }
+
+    owned_int::moves = 0;
+    EXPECT_EQ(to + 4, hfl::uninitialized_relocate_n(from, 4, to));
+    EXPECT_EQ(0, owned_int::moves);
+    EXPECT_EQ(0, *to[0].unwrap_ref().m_value);
+    EXPECT_EQ(true, to[1].is_err_and([](int e) { return e == 1; }));
+    EXPECT_EQ(2, *to[2].unwrap_ref().m_value);
+    EXPECT_EQ(true, to[3].is_err_and([](int e) { return e == 3; }));
+    std::destroy_n(to, 4);
+}
+
+TEST(relocatable_test, other_types_are_moved_and_destroyed)
+{
+    using result = hfl::rs_result<std::string, int>;
+    alignas(result) unsigned char from_buf[sizeof(result) * 2];
+    alignas(result) unsigned char to_buf[sizeof(result) * 2];
+    auto* from = reinterpret_cast<result*>(from_buf);
+    auto* to = reinterpret_cast<result*>(to_buf);
+    std::construct_at(from, hfl::ok{std::string{"a string too long for the small buffer"}});
+    std::construct_at(from + 1, hfl::err{7});
+
+    hfl::uninitialized_relocate_n(from, 2, to);
+    EXPECT_EQ("a string too long for the small buffer", to[0].unwrap_ref());
+    EXPECT_EQ(7, to[1].unwrap_err());
+    std::destroy_n(to, 2);
+}
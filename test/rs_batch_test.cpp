@@ -0,0 +1,107 @@
+#include "rs_batch.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using result_type = hfl::rs_result<double, std::string>;
+using batch_type = hfl::rs_batch<double, std::string>;
+
+static std::vector<result_type> make_results(size_t n)
+{
+    std::vector<result_type> results;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (i % 7 == 3)
+        {
+            results.emplace_back(hfl::err<std::string>{"bad " + std::to_string(i)});
+        }
+        else
+        {
+            results.emplace_back(hfl::ok{static_cast<double>(i)});
+        }
+    }
+    return results;
+}
+
+TEST(rs_batch_test, rs_batch_round_trip)
+{
+    const auto results = make_results(150);
+    batch_type batch{results};
+    EXPECT_EQ(150u, batch.size());
+    EXPECT_EQ(21u, batch.err_count());
+    EXPECT_EQ(129u, batch.ok_count());
+    EXPECT_EQ(3u, batch.validity().size());
+    EXPECT_EQ(true, batch.is_err(3));
+    EXPECT_EQ("bad 10", batch.error(10));
+    EXPECT_EQ(8.0, batch[8].unwrap());
+    EXPECT_THROW(batch.error(8), hfl::unwrap_err_exception<double>);
+
+    const auto back = batch.to_results();
+    ASSERT_EQ(results.size(), back.size());
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(results[i].is_ok(), back[i].is_ok());
+        if (results[i].is_ok())
+        {
+            EXPECT_EQ(results[i].unwrap(), back[i].unwrap());
+        }
+        else
+        {
+            EXPECT_EQ(results[i].unwrap_err(), back[i].unwrap_err());
+        }
+    }
+}
+
+TEST(rs_batch_test, rs_batch_rejects_bool)
+{
+    static_assert(hfl::rs_batch_value<int>);
+    static_assert(hfl::rs_batch_value<std::uint8_t>);
+    static_assert(!hfl::rs_batch_value<bool>);
+    static_assert(!hfl::rs_batch_value<const bool>);
+
+    hfl::rs_batch<std::uint8_t, std::string> flags;
+    flags.push_ok(std::uint8_t{1});
+    flags.push_err(std::string{"unknown"});
+    EXPECT_EQ(1, flags.values()[0]);
+    EXPECT_EQ(true, flags.is_err(1));
+}
+
+TEST(rs_batch_test, rs_batch_map)
+{
+    batch_type batch{make_results(100)};
+    auto halves = batch.map([](double v) { return static_cast<int>(v) / 2; });
+    static_assert(std::is_same_v<decltype(halves), hfl::rs_batch<int, std::string>>);
+    EXPECT_EQ(batch.err_count(), halves.err_count());
+    EXPECT_EQ(49, halves[99].unwrap());
+    EXPECT_EQ("bad 3", halves[3].unwrap_err());
+}
+
+TEST(rs_batch_test, rs_batch_and_then)
+{
+    batch_type batch{make_results(100)};
+    int calls{0};
+    auto checked = batch.and_then([&calls](double v) {
+        ++calls;
+        return static_cast<int>(v) % 5 == 0 ? result_type{hfl::err<std::string>{"five"}} : result_type{hfl::ok{-v}};
+    });
+    EXPECT_EQ(static_cast<int>(batch.ok_count()), calls);
+    EXPECT_EQ(-1.0, checked[1].unwrap());
+    EXPECT_EQ("five", checked[0].unwrap_err());
+    EXPECT_EQ("bad 3", checked[3].unwrap_err());
+    EXPECT_EQ("five", checked[95].unwrap_err());
+    EXPECT_EQ(batch.err_count() + 17, checked.err_count());
+    EXPECT_EQ(true, std::is_sorted(checked.errors().begin(), checked.errors().end(),
+                                   [](const auto& a, const auto& b) { return a.first < b.first; }));
+}
+
+TEST(rs_batch_test, rs_batch_filter)
+{
+    batch_type batch{make_results(70)};
+    auto small = batch.filter([](double v) { return v < 64.0; }, "too big");
+    EXPECT_EQ(true, small.is_ok(63));
+    EXPECT_EQ("too big", small.error(64));
+    EXPECT_EQ("bad 66", small.error(66));
+    EXPECT_EQ(batch.err_count() + 5, small.err_count());
+    EXPECT_EQ(small.size(), small.to_results().size());
+}
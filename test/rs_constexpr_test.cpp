@@ -0,0 +1,126 @@
+#include "rs_option.hpp"
+#include "rs_result.hpp"
+#include <array>
+#include <gtest/gtest.h>
+#include <string_view>
+
+namespace
+{
+
+using result = hfl::rs_result<int, std::string_view>;
+
+constexpr result parse_digit(char c)
+{
+    if (c < '0' or c > '9')
+    {
+        return result{hfl::err<std::string_view>{"not a digit"}};
+    }
+    return result{hfl::ok{c - '0'}};
+}
+
+constexpr result non_zero(int x)
+{
+    return x == 0 ? result{hfl::err<std::string_view>{"zero"}} : result{hfl::ok{x}};
+}
+
+constexpr int twice(int x)
+{
+    return x * 2;
+}
+
+struct port_entry
+{
+    std::string_view m_name;
+    int m_port;
+};
+
+constexpr std::array<port_entry, 3> port_table{{{"http", 80}, {"https", 443}, {"admin", 8080}}};
+
+constexpr hfl::rs_result<int, std::string_view> check_port(const port_entry& entry)
+{
+    if (entry.m_port <= 0 or entry.m_port > 65535)
+    {
+        return hfl::rs_result<int, std::string_view>{hfl::err<std::string_view>{entry.m_name}};
+    }
+    return hfl::rs_result<int, std::string_view>{hfl::ok{entry.m_port}};
+}
+
+template<size_t N>
+constexpr hfl::rs_result<int, std::string_view> validate_ports(const std::array<port_entry, N>& table)
+{
+    int sum = 0;
+    for (const auto& entry : table)
+    {
+        auto res = check_port(entry);
+        if (res.is_err())
+        {
+            return res;
+        }
+        sum += res.unwrap();
+    }
+    return hfl::rs_result<int, std::string_view>{hfl::ok{sum}};
+}
+
+// Configuration is checked while building, a bad entry fails the build.
+static_assert(validate_ports(port_table).unwrap() == 8603);
+static_assert(validate_ports(std::array<port_entry, 1>{{{"bad", 70000}}}).unwrap_err() == "bad");
+
+// Accessors and combinators.
+static_assert(parse_digit('7').is_ok());
+static_assert(parse_digit('x').is_err_and([](std::string_view e) { return e == "not a digit"; }));
+static_assert(parse_digit('7').is_ok_and([](int x) { return x == 7; }));
+static_assert(parse_digit('7').unwrap_ref() == 7);
+static_assert(parse_digit('7').unwrap_unchecked() == 7);
+static_assert(parse_digit('7').unwrap_or_default(0) == 7);
+static_assert(parse_digit('x').unwrap_or_default(-1) == -1);
+static_assert(parse_digit('7').expect("a digit") == 7);
+static_assert(parse_digit('4').map(twice).unwrap() == 8);
+static_assert(parse_digit('x').map(twice).unwrap_err() == "not a digit");
+static_assert(parse_digit('4').map_or(0, twice) == 8);
+static_assert(parse_digit('x').map_or(0, twice) == 0);
+static_assert(parse_digit('x').map_or_else([] { return -1; }, twice) == -1);
+static_assert(parse_digit('x').map_err([](std::string_view e) { return e.size(); }).unwrap_err() == 11);
+static_assert(parse_digit('0').and_then(non_zero).unwrap_err() == "zero");
+static_assert(parse_digit('x').or_else([](std::string_view) { return result{hfl::ok{0}}; }).unwrap() == 0);
+static_assert(parse_digit('3').copied().unwrap() == 3);
+static_assert(parse_digit('3').match([](const auto& v) { return v.m_value; }, [](const auto&) { return -1; }) == 3);
+
+constexpr int lvalue_combinators()
+{
+    const result r = parse_digit('5');
+    auto a = r.map(twice).and_then(non_zero);
+    auto b = r.map_err([](std::string_view e) { return e.size(); });
+    result c = parse_digit('x');
+    swap(c, a);
+    return a.unwrap_err().size() + b.unwrap() + c.unwrap() + r.as_ref().unwrap();
+}
+static_assert(lvalue_combinators() == 11 + 5 + 10 + 5);
+
+// mbind, operator| and fused pipelines.
+static_assert((parse_digit('6') | non_zero).unwrap() == 6);
+static_assert(hfl::pipeline(parse_digit('3'), twice, non_zero, twice).unwrap() == 12);
+static_assert(hfl::pipeline(parse_digit('0'), twice, non_zero, twice).unwrap_err() == "zero");
+static_assert(hfl::make_pipeline(twice).then(non_zero)(parse_digit('2')).unwrap() == 4);
+
+consteval int checked_digit(char c)
+{
+    return parse_digit(c).and_then(non_zero).unwrap();
+}
+static_assert(checked_digit('9') == 9);
+
+// rs_option, including niche storage.
+static_assert(hfl::rs_option<int>{hfl::some{3}}.unwrap() == 3);
+static_assert(hfl::rs_option<int>{hfl::none{}}.is_none());
+static_assert(hfl::rs_option<int>{hfl::none{}}.unwrap_or_default(5) == 5);
+static_assert(hfl::rs_option<const port_entry*>{hfl::some{&port_table[1]}}.unwrap()->m_port == 443);
+static_assert(hfl::rs_option<const port_entry*>{hfl::none{}}.is_none());
+
+} // namespace
+
+TEST(rs_constexpr_test, constant_evaluated_results_match_runtime)
+{
+    constexpr auto at_compile_time = hfl::pipeline(parse_digit('3'), twice, non_zero, twice);
+    auto at_run_time = hfl::pipeline(parse_digit('3'), twice, non_zero, twice);
+    EXPECT_EQ(at_compile_time.unwrap(), at_run_time.unwrap());
+    EXPECT_EQ(8603, validate_ports(port_table).unwrap());
+}
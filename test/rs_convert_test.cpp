@@ -0,0 +1,174 @@
+#include "rs_convert.hpp"
+#include "copy_counter.hpp"
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+
+using counted_result = hfl::rs_result<copy_counter, std::string>;
+using counted_option = hfl::rs_option<copy_counter>;
+
+static counted_option make_some(int v)
+{
+    return counted_option{hfl::some<copy_counter>{v}};
+}
+
+static counted_result make_ok(int v)
+{
+    return counted_result{std::in_place_type<counted_result::ok_type>, v};
+}
+
+TEST(rs_convert_test, optional_round_trip)
+{
+    hfl::rs_option<int> a{1};
+    hfl::rs_option<int> n{hfl::none{}};
+    EXPECT_EQ(std::optional<int>{1}, hfl::to_optional(a));
+    EXPECT_EQ(std::nullopt, hfl::to_optional(n));
+    EXPECT_EQ(1, hfl::to_option(std::optional<int>{1}).unwrap());
+    EXPECT_TRUE(hfl::to_option(std::optional<int>{}).is_none());
+
+    hfl::rs_result<int, std::string> ok{1};
+    hfl::rs_result<int, std::string> bad{hfl::err<std::string>{"bad"}};
+    EXPECT_EQ(std::optional<int>{1}, hfl::to_optional(ok));
+    EXPECT_EQ(std::nullopt, hfl::to_optional(bad));
+    EXPECT_EQ(1, hfl::to_option(ok).unwrap());
+    EXPECT_TRUE(hfl::to_option(bad).is_none());
+}
+
+TEST(rs_convert_test, optional_ok_or)
+{
+    EXPECT_EQ(2, hfl::ok_or(std::optional<int>{2}, std::string{"missing"}).unwrap());
+    EXPECT_EQ("missing", hfl::ok_or(std::optional<int>{}, std::string{"missing"}).unwrap_err());
+    EXPECT_EQ(3, hfl::ok_or(std::optional<int>{}, 3).unwrap_err());
+}
+
+TEST(rs_convert_test, transpose)
+{
+    using result_type = hfl::rs_result<int, std::string>;
+    using option_type = hfl::rs_option<result_type>;
+
+    auto some_ok = hfl::transpose(option_type{result_type{1}});
+    EXPECT_EQ(1, some_ok.unwrap().unwrap());
+    auto some_err = hfl::transpose(option_type{result_type{hfl::err<std::string>{"bad"}}});
+    EXPECT_EQ("bad", some_err.unwrap_err());
+    auto nothing = hfl::transpose(option_type{hfl::none{}});
+    EXPECT_TRUE(nothing.unwrap().is_none());
+
+    EXPECT_EQ(1, hfl::transpose(some_ok).unwrap().unwrap());
+    EXPECT_EQ("bad", hfl::transpose(some_err).unwrap().unwrap_err());
+    EXPECT_TRUE(hfl::transpose(nothing).is_none());
+}
+
+TEST(rs_convert_test, error_code_round_trip)
+{
+    hfl::result<int> good{4};
+    hfl::result<int> bad{std::make_error_code(std::errc::io_error)};
+    EXPECT_EQ(4, hfl::from_error_code(good).unwrap());
+    EXPECT_EQ(std::make_error_code(std::errc::io_error), hfl::from_error_code(bad).unwrap_err());
+    EXPECT_EQ(4, hfl::to_result(hfl::from_error_code(good)).value());
+    EXPECT_EQ(std::make_error_code(std::errc::io_error), hfl::to_result(hfl::from_error_code(bad)).error_code());
+}
+
+TEST(rs_convert_test, rvalue_conversions_move_once)
+{
+    auto option = make_some(1);
+    copy_counter::reset();
+    auto optional = hfl::to_optional(std::move(option));
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+
+    copy_counter::reset();
+    auto back = hfl::to_option(std::move(optional));
+    EXPECT_EQ(1, back.unwrap_ref().m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+
+    copy_counter::reset();
+    auto result = hfl::ok_or(std::optional<copy_counter>{std::in_place, 2}, std::string{"missing"});
+    EXPECT_EQ(2, result.unwrap_ref().m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+
+    copy_counter::reset();
+    auto member = std::move(back).ok_or(std::string{"missing"});
+    EXPECT_EQ(1, member.unwrap_ref().m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+
+    copy_counter::reset();
+    auto dropped = hfl::to_option(std::move(member));
+    EXPECT_EQ(1, dropped.unwrap_ref().m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+}
+
+TEST(rs_convert_test, transpose_moves_once)
+{
+    hfl::rs_option<counted_result> option{make_ok(3)};
+    copy_counter::reset();
+    auto transposed = hfl::transpose(std::move(option));
+    EXPECT_EQ(3, transposed.unwrap_ref().unwrap_ref().m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+
+    copy_counter::reset();
+    auto back = hfl::transpose(std::move(transposed));
+    EXPECT_EQ(3, back.unwrap_ref().unwrap_ref().m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+}
+
+TEST(rs_convert_test, error_code_conversions_move_once)
+{
+    hfl::result<copy_counter> source{copy_counter{5}};
+    copy_counter::reset();
+    auto result = hfl::from_error_code(std::move(source));
+    EXPECT_EQ(5, result.unwrap_ref().m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+
+    copy_counter::reset();
+    auto back = hfl::to_result(std::move(result));
+    EXPECT_TRUE(back.has_value());
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+}
+
+TEST(rs_convert_test, lvalue_conversions_copy_once)
+{
+    const auto option = make_some(6);
+    copy_counter::reset();
+    auto optional = hfl::to_optional(option);
+    EXPECT_EQ(1, copy_counter::copies);
+    EXPECT_EQ(0, copy_counter::moves);
+
+    const hfl::rs_option<counted_result> nested{make_ok(7)};
+    copy_counter::reset();
+    auto transposed = hfl::transpose(nested);
+    EXPECT_EQ(7, transposed.unwrap_ref().unwrap_ref().m_value);
+    EXPECT_EQ(1, copy_counter::copies);
+    EXPECT_EQ(0, copy_counter::moves);
+    EXPECT_EQ(6, optional->m_value);
+}
+
+#ifdef HFL_HAS_EXPECTED
+TEST(rs_convert_test, expected_round_trip_moves_once)
+{
+    auto source = make_ok(8);
+    copy_counter::reset();
+    std::expected<copy_counter, std::string> expected = hfl::to_expected(std::move(source));
+    EXPECT_EQ(8, expected->m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+
+    copy_counter::reset();
+    auto back = hfl::from_expected(std::move(expected));
+    EXPECT_EQ(8, back.unwrap_ref().m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, copy_counter::moves);
+
+    counted_result bad{hfl::err<std::string>{"bad"}};
+    EXPECT_EQ("bad", hfl::from_expected(hfl::to_expected(bad)).unwrap_err());
+}
+#endif
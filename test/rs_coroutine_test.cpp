@@ -0,0 +1,137 @@
+#include "rs_coroutine.hpp"
+#include <array>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+using int_result = hfl::rs_result<int, std::string>;
+
+static int_result parse_digit(char c)
+{
+    if (c < '0' or c > '9')
+    {
+        return int_result{hfl::err<std::string>{std::string{"not a digit: "} + c}};
+    }
+    return int_result{hfl::ok{c - '0'}};
+}
+
+static int_result parse_pair(const std::string& s)
+{
+    const int tens = co_await parse_digit(s[0]);
+    const int ones = co_await parse_digit(s[1]);
+    co_return tens * 10 + ones;
+}
+
+static int_result nested(const std::string& a, const std::string& b)
+{
+    int_result first = parse_pair(a);
+    const int x = co_await first;
+    const int y = co_await parse_pair(b);
+    if (x + y > 100)
+    {
+        co_return hfl::err<std::string>{"too big"};
+    }
+    co_return x + y;
+}
+
+TEST(rs_coroutine_test, co_await_ok)
+{
+    EXPECT_EQ(42, parse_pair("42").unwrap());
+    EXPECT_EQ(54, nested("12", "42").unwrap());
+    EXPECT_EQ(0u, hfl::coroutine_frame_stack::used());
+}
+
+TEST(rs_coroutine_test, co_await_err_returns_early)
+{
+    EXPECT_EQ("not a digit: x", parse_pair("4x").unwrap_err());
+    EXPECT_EQ("not a digit: y", nested("12", "y2").unwrap_err());
+    EXPECT_EQ("too big", nested("99", "02").unwrap_err());
+    EXPECT_EQ(0u, hfl::coroutine_frame_stack::used());
+}
+
+static hfl::rs_result<std::string, std::string> move_through(hfl::rs_result<std::string, std::string> in)
+{
+    std::string s = co_await std::move(in);
+    s += "!";
+    co_return hfl::ok<std::string>{std::move(s)};
+}
+
+TEST(rs_coroutine_test, co_await_moves_rvalue_payload)
+{
+    hfl::rs_result<std::string, std::string> in{hfl::ok<std::string>{"hello"}};
+    EXPECT_EQ("hello!", move_through(std::move(in)).unwrap());
+}
+
+static size_t frame_usage{0};
+
+static int_result observe_frame()
+{
+    frame_usage = hfl::coroutine_frame_stack::used();
+    co_return 1;
+}
+
+static int_result deep(int depth)
+{
+    if (depth == 0)
+    {
+        co_return co_await observe_frame();
+    }
+    co_return 1 + co_await deep(depth - 1);
+}
+
+TEST(rs_coroutine_test, frames_use_the_frame_stack)
+{
+    EXPECT_EQ(1, observe_frame().unwrap());
+    EXPECT_GT(frame_usage, 0u);
+    EXPECT_EQ(0u, hfl::coroutine_frame_stack::used());
+    // Deeper than the buffer holds, the rest falls back to the heap.
+    EXPECT_EQ(5'001, deep(5'000).unwrap());
+    EXPECT_EQ(0u, hfl::coroutine_frame_stack::used());
+}
+
+static hfl::rs_option<int> half(int v)
+{
+    if (v % 2 != 0)
+    {
+        return hfl::rs_option<int>{hfl::none{}};
+    }
+    return hfl::rs_option<int>{hfl::some{v / 2}};
+}
+
+static hfl::rs_option<int> quarter(int v)
+{
+    const int h = co_await half(v);
+    co_return co_await half(h);
+}
+
+TEST(rs_coroutine_test, rs_option_co_await)
+{
+    EXPECT_EQ(3, quarter(12).unwrap());
+    EXPECT_EQ(true, quarter(6).is_none());
+    EXPECT_EQ(true, quarter(7).is_none());
+}
+
+static int_result throws_inside()
+{
+    co_await parse_digit('1');
+    throw std::runtime_error{"boom"};
+    co_return 0;
+}
+
+// The buffer lives across the throw, so the frame is too big for the frame
+// stack and comes from the heap.
+static int_result throws_from_heap_frame()
+{
+    std::array<char, HFL_COROUTINE_FRAME_STACK_SIZE> buffer{};
+    buffer[0] = static_cast<char>(co_await parse_digit('1'));
+    throw std::runtime_error{std::string(buffer.data(), 1)};
+    co_return 0;
+}
+
+TEST(rs_coroutine_test, exception_reaches_caller)
+{
+    EXPECT_THROW(static_cast<void>(throws_inside()), std::runtime_error);
+    EXPECT_EQ(0u, hfl::coroutine_frame_stack::used());
+    EXPECT_THROW(static_cast<void>(throws_from_heap_frame()), std::runtime_error);
+    EXPECT_EQ(0u, hfl::coroutine_frame_stack::used());
+}
@@ -1,7 +1,9 @@
 #include "rs_option.hpp"
+#include "copy_counter.hpp"
 #include <gtest/gtest.h>
 #include <system_error>
 #include <string>
+#include <utility>
 
 struct test_move_string
 {
@@ -29,8 +31,138 @@ struct test_move_string
     std::string m_buf;
 };
 
+using counted_option = hfl::rs_option<copy_counter>;
+
 
 TEST(rs_option_test, rs_option_match)
 {
     hfl::rs_option<int> r1{1};
-}
\ No newline at end of file
+    hfl::rs_option<int> r2{hfl::none{}};
+    auto on_some = [](const hfl::some<int>& v) { return v.m_value; };
+    auto on_none = []() { return -1; };
+    EXPECT_EQ(1, r1.match(on_some, on_none));
+    EXPECT_EQ(-1, r2.match(on_some, on_none));
+    EXPECT_EQ(1, std::as_const(r1).match(on_some, on_none));
+    EXPECT_EQ(-1, std::move(r2).match([](hfl::some<int>&& v) { return v.m_value; }, on_none));
+}
+TEST(rs_option_test, rs_option_unwrap_ref)
+{
+    hfl::rs_option<test_move_string> a{hfl::some<test_move_string>{"value"}};
+    hfl::rs_option<test_move_string> b{hfl::none{}};
+    const auto& ca = a;
+    EXPECT_EQ(&a.unwrap_ref(), &ca.unwrap_ref());
+    EXPECT_EQ(&a.unwrap_ref(), &a.unwrap_unchecked());
+    EXPECT_THROW(b.unwrap_ref(), hfl::unwrap_none_exception);
+
+    test_move_string moved = std::move(a).unwrap_ref();
+    EXPECT_EQ("value", moved.m_buf);
+    EXPECT_EQ(true, a.unwrap_unchecked().m_buf.empty());
+}
+
+TEST(rs_option_test, rs_option_map_and_then)
+{
+    hfl::rs_option<int> a{2};
+    hfl::rs_option<int> b{hfl::none{}};
+    auto half = [](int v) { return v % 2 == 0 ? hfl::rs_option<int>{v / 2} : hfl::rs_option<int>{hfl::none{}}; };
+
+    EXPECT_EQ("2", a.map([](int v) { return std::to_string(v); }).unwrap());
+    EXPECT_TRUE(b.map([](int v) { return v + 1; }).is_none());
+    EXPECT_EQ(1, a.and_then(half).unwrap());
+    EXPECT_TRUE(a.and_then(half).and_then(half).is_none());
+    EXPECT_TRUE(b.and_then(half).is_none());
+    static_assert(noexcept(a.map([](int v) noexcept { return v; })));
+    static_assert(!noexcept(a.map([](int v) { return v; })));
+}
+
+TEST(rs_option_test, rs_option_or_else_filter)
+{
+    hfl::rs_option<int> a{3};
+    hfl::rs_option<int> b{hfl::none{}};
+    auto fallback = []() { return hfl::rs_option<int>{7}; };
+
+    EXPECT_EQ(3, a.or_else(fallback).unwrap());
+    EXPECT_EQ(7, b.or_else(fallback).unwrap());
+    EXPECT_EQ(3, a.filter([](int v) { return v > 2; }).unwrap());
+    EXPECT_TRUE(a.filter([](int v) { return v > 3; }).is_none());
+    EXPECT_TRUE(b.filter([](int) { return true; }).is_none());
+}
+
+TEST(rs_option_test, rs_option_take_replace)
+{
+    hfl::rs_option<test_move_string> a{hfl::some<test_move_string>{"first"}};
+    auto taken = a.take();
+    EXPECT_TRUE(a.is_none());
+    EXPECT_EQ("first", taken.unwrap_ref().m_buf);
+    EXPECT_TRUE(a.take().is_none());
+
+    auto old = a.replace("second");
+    EXPECT_TRUE(old.is_none());
+    old = a.replace("third");
+    EXPECT_EQ("second", old.unwrap_ref().m_buf);
+    EXPECT_EQ("third", a.unwrap_ref().m_buf);
+}
+
+TEST(rs_option_test, rs_option_ok_or_zip)
+{
+    hfl::rs_option<int> a{1};
+    hfl::rs_option<std::string> b{hfl::some<std::string>{"b"}};
+    hfl::rs_option<int> n{hfl::none{}};
+
+    EXPECT_EQ(1, a.ok_or(std::string{"missing"}).unwrap());
+    EXPECT_EQ("missing", n.ok_or(std::string{"missing"}).unwrap_err());
+    EXPECT_EQ(std::make_pair(1, std::string{"b"}), a.zip(b).unwrap());
+    EXPECT_TRUE(a.zip(n).is_none());
+    EXPECT_TRUE(n.zip(b).is_none());
+}
+
+TEST(rs_option_test, rs_option_rvalue_combinators_do_not_copy)
+{
+    copy_counter::reset();
+    auto bump = [](copy_counter&& v) {
+        v.m_value += 1;
+        return std::move(v);
+    };
+    auto keep = [](copy_counter&& v) { return counted_option{hfl::some<copy_counter>{std::move(v)}}; };
+    auto positive = [](const copy_counter& v) { return v.m_value > 0; };
+
+    auto r = counted_option{hfl::some<copy_counter>{1}}
+                 .map(bump)
+                 .and_then(keep)
+                 .filter(positive)
+                 .or_else([]() { return counted_option{hfl::none{}}; });
+    EXPECT_EQ(2, r.unwrap_ref().m_value);
+
+    auto result = std::move(r).ok_or(0);
+    EXPECT_EQ(2, result.unwrap_ref().m_value);
+
+    auto zipped = counted_option{hfl::some<copy_counter>{3}}.zip(counted_option{hfl::some<copy_counter>{4}});
+    EXPECT_EQ(3, zipped.unwrap_ref().first.m_value);
+    EXPECT_EQ(4, zipped.unwrap_ref().second.m_value);
+
+    counted_option slot{hfl::some<copy_counter>{5}};
+    auto taken = slot.take();
+    auto previous = slot.replace(copy_counter{6});
+    EXPECT_EQ(5, taken.unwrap_ref().m_value);
+    EXPECT_TRUE(previous.is_none());
+    EXPECT_EQ(0, copy_counter::copies);
+}
+
+TEST(rs_option_test, rs_option_const_combinators_copy_once)
+{
+    const counted_option a{hfl::some<copy_counter>{1}};
+
+    copy_counter::reset();
+    auto filtered = a.filter([](const copy_counter&) { return true; });
+    EXPECT_EQ(1, copy_counter::copies);
+
+    copy_counter::reset();
+    auto result = a.ok_or(0);
+    EXPECT_EQ(1, copy_counter::copies);
+
+    copy_counter::reset();
+    auto mapped = a.map([](const copy_counter& v) { return v.m_value; });
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(1, mapped.unwrap());
+    EXPECT_EQ(1, filtered.unwrap_ref().m_value);
+    EXPECT_EQ(1, result.unwrap_ref().m_value);
+}
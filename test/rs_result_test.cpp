@@ -1,5 +1,7 @@
 #include "rs_result.hpp"
+#include "copy_counter.hpp"
 #include <gtest/gtest.h>
+#include <stdexcept>
 #include <system_error>
 #include <string>
 
@@ -386,4 +388,180 @@ TEST(rs_result_test, rs_result_test_move_pipeline)
     auto r3 = hfl::pipeline(std::move(c) , f2 , f1);
     EXPECT_EQ("123ba", r3.unwrap().m_buf);
     EXPECT_EQ(true, c.unwrap().m_buf.empty());
-}
\ No newline at end of file
+}
+TEST(rs_result_test, rs_result_function_ref_match)
+{
+    int flag{0};
+    auto on_ok = [&flag](const hfl::rs_result<int, std::string>::ok_type& v) { flag = v.m_value; return 1; };
+    auto on_err = [&flag](const hfl::rs_result<int, std::string>::err_type&) { flag = -1; return 2; };
+    hfl::rs_result<int, std::string> a{hfl::ok{5}};
+    hfl::rs_result<int, std::string> b{hfl::err<std::string>{"e"}};
+    using ok_ref = hfl::function_ref<int(const hfl::rs_result<int, std::string>::ok_type&)>;
+    using err_ref = hfl::function_ref<int(const hfl::rs_result<int, std::string>::err_type&)>;
+    EXPECT_EQ(1, a.match(ok_ref{on_ok}, err_ref{on_err}));
+    EXPECT_EQ(5, flag);
+    EXPECT_EQ(2, b.match(ok_ref{on_ok}, err_ref{on_err}));
+    EXPECT_EQ(-1, flag);
+}
+
+TEST(rs_result_test, rs_result_function_ref_map_and_then_or_else)
+{
+    hfl::rs_result<int, std::string> a{hfl::ok{3}};
+    hfl::rs_result<int, std::string> c{hfl::err<std::string>{"c"}};
+    auto twice = [](int v) { return double(2 * v); };
+    auto b = a.map(hfl::function_ref<double(int)>{twice});
+    static_assert(std::is_same_v<decltype(b), hfl::rs_result<double, std::string>>);
+    EXPECT_EQ(6.0, b.unwrap());
+    EXPECT_EQ(true, c.map(hfl::function_ref<double(int)>{twice}).is_err());
+
+    using step_ref = hfl::function_ref<hfl::rs_result<int, std::string>(int)>;
+    EXPECT_EQ(18, a.and_then(step_ref{times_by_two}).and_then(step_ref{times_by_three}).unwrap());
+    EXPECT_EQ(true, c.and_then(step_ref{times_by_two}).is_err());
+
+    using recover_ref = hfl::function_ref<hfl::rs_result<int, std::string>(const std::string&)>;
+    EXPECT_EQ("ca", c.or_else(recover_ref{append_a}).unwrap_err());
+    EXPECT_EQ(3, a.or_else(recover_ref{append_a}).unwrap());
+}
+
+TEST(rs_result_test, rs_result_rvalue_combinators_do_not_copy)
+{
+    using result_type = hfl::rs_result<copy_counter, copy_counter>;
+    auto step = [](copy_counter&& v) {
+        v.m_value += 1;
+        return result_type{hfl::ok<copy_counter>{std::move(v)}};
+    };
+    auto grow = [](copy_counter&& v) {
+        v.m_value *= 2;
+        return std::move(v);
+    };
+    copy_counter::reset();
+
+    result_type a{hfl::ok<copy_counter>{copy_counter{1}}};
+    auto b = std::move(a).and_then(step).and_then(step).map(grow).map_err(grow);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(6, std::move(b).copied().unwrap().m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+
+    result_type c{hfl::err<copy_counter>{copy_counter{5}}};
+    auto d = std::move(c).and_then(step).map(grow).map_err(grow).or_else([](copy_counter&& e) {
+        return result_type{hfl::ok<copy_counter>{std::move(e)}};
+    });
+    EXPECT_EQ(10, std::move(d).unwrap().m_value);
+    EXPECT_EQ(1, std::move(result_type{hfl::err<copy_counter>{copy_counter{1}}}).unwrap_err().m_value);
+    EXPECT_EQ(2, std::move(result_type{hfl::ok<copy_counter>{copy_counter{1}}}).map_or(copy_counter{0}, grow).m_value);
+    EXPECT_EQ(0, copy_counter::copies);
+}
+
+TEST(rs_result_test, rs_result_expect_reports_message)
+{
+    hfl::rs_result<int, std::string> b{hfl::err<std::string>{"error"}};
+    try
+    {
+        b.expect(std::string{"config must be loaded"});
+        FAIL();
+    }
+    catch (const hfl::unwrap_exception<std::string>& e)
+    {
+        EXPECT_STREQ("config must be loaded", e.what());
+        EXPECT_EQ("error", e.m_e.m_value);
+    }
+    EXPECT_THROW(std::move(b).expect("moved"), hfl::unwrap_exception<std::string>);
+
+    // By value on every overload, so expect on a temporary cannot dangle.
+    const hfl::rs_result<std::string, int> a{hfl::ok<std::string>{"value"}};
+    static_assert(std::is_same_v<decltype(a.expect("")), std::string>);
+    static_assert(std::is_same_v<decltype(std::move(a).expect("")), std::string>);
+    static_assert(std::is_same_v<decltype(hfl::rs_result<std::string, int>{}.expect("")), std::string>);
+}
+
+TEST(rs_result_test, rs_result_unwrap_ref)
+{
+    hfl::rs_result<std::string, std::string> a{hfl::ok<std::string>{"value"}};
+    hfl::rs_result<std::string, std::string> b{hfl::err<std::string>{"error"}};
+    const auto& ca = a;
+    EXPECT_EQ(&a.unwrap_ref(), &ca.unwrap_ref());
+    EXPECT_EQ(&a.unwrap_ref(), &a.unwrap_unchecked());
+    EXPECT_EQ(&b.unwrap_err_ref(), &b.unwrap_err_unchecked());
+    EXPECT_EQ("value", ca.expect("ok"));
+    EXPECT_THROW(b.expect("ok"), hfl::unwrap_exception<std::string>);
+    EXPECT_THROW(b.unwrap_ref(), hfl::unwrap_exception<std::string>);
+    EXPECT_THROW(a.unwrap_err_ref(), hfl::unwrap_err_exception<std::string>);
+
+    a.unwrap_ref() += "!";
+    EXPECT_EQ("value!", a.unwrap_unchecked());
+    std::string moved = std::move(a).unwrap_ref();
+    EXPECT_EQ("value!", moved);
+    EXPECT_EQ(true, a.unwrap_ref().empty());
+    static_assert(std::is_same_v<decltype(std::move(b).unwrap_err_unchecked()), std::string&&>);
+
+    int target{1};
+    auto r = hfl::rs_result<int&, std::string>{hfl::ok<int&>{target}};
+    EXPECT_EQ(&target, &r.unwrap_ref());
+}
+
+TEST(rs_result_test, rs_result_fused_pipeline)
+{
+    int calls{0};
+    auto half = [&calls](int v) {
+        ++calls;
+        return v % 2 == 0 ? hfl::rs_result<int, std::string>{hfl::ok{v / 2}}
+                          : hfl::rs_result<int, std::string>{hfl::err<std::string>{"odd"}};
+    };
+    auto to_double = [&calls](int v) {
+        ++calls;
+        return v * 1.5;
+    };
+    const auto p = hfl::make_pipeline(half, half).then(to_double);
+
+    auto a = p(hfl::rs_result<int, std::string>{hfl::ok{8}});
+    static_assert(std::is_same_v<decltype(a), hfl::rs_result<double, std::string>>);
+    EXPECT_EQ(3.0, a.unwrap());
+    EXPECT_EQ(3, calls);
+
+    calls = 0;
+    const hfl::rs_result<int, std::string> b{hfl::ok{6}};
+    EXPECT_EQ("odd", p(b).unwrap_err());
+    EXPECT_EQ(2, calls);
+
+    calls = 0;
+    EXPECT_EQ("in", p(hfl::rs_result<int, std::string>{hfl::err<std::string>{"in"}}).unwrap_err());
+    EXPECT_EQ(0, calls);
+}
+
+TEST(rs_result_test, rs_result_fused_pipeline_does_not_copy)
+{
+    using result_type = hfl::rs_result<copy_counter, int>;
+    auto step = [](copy_counter&& v) {
+        v.m_value += 1;
+        return result_type{hfl::ok<copy_counter>{std::move(v)}};
+    };
+    auto grow = [](copy_counter&& v) {
+        v.m_value *= 2;
+        return std::move(v);
+    };
+    copy_counter::reset();
+    auto r = hfl::pipeline(result_type{hfl::ok<copy_counter>{copy_counter{1}}}, step, grow, step, step);
+    EXPECT_EQ(0, copy_counter::copies);
+    EXPECT_EQ(6, std::move(r).unwrap().m_value);
+}
+
+TEST(rs_result_test, rs_result_const_combinators_propagate_noexcept)
+{
+    using result_type = hfl::rs_result<int, std::string>;
+    const result_type bad{hfl::err<std::string>{"bad"}};
+    auto recover = [](const std::string& e) noexcept { return result_type{static_cast<int>(e.size())}; };
+    auto recover_throwing = [](const std::string& e) -> result_type { throw std::runtime_error{e}; };
+    auto wrap = [](const std::string& e) noexcept { return e.size(); };
+    auto wrap_throwing = [](const std::string& e) -> std::size_t { throw std::runtime_error{e}; };
+
+    static_assert(noexcept(bad.or_else(recover)));
+    static_assert(!noexcept(bad.or_else(recover_throwing)));
+    static_assert(noexcept(bad.map_err(wrap)));
+    static_assert(!noexcept(bad.map_err(wrap_throwing)));
+    const hfl::rs_result<std::string, int> named{std::string{"name"}};
+    static_assert(!noexcept(named.map_err([](int) noexcept { return 0; })));
+
+    EXPECT_EQ(3, bad.or_else(recover).unwrap());
+    EXPECT_THROW(bad.or_else(recover_throwing), std::runtime_error);
+    EXPECT_THROW(bad.map_err(wrap_throwing), std::runtime_error);
+}
@@ -0,0 +1,107 @@
+#include "rs_option.hpp"
+#include "rs_result.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+
+enum class color : std::uint8_t
+{
+    red,
+    green,
+    blue,
+    invalid = 0xff,
+};
+
+template<>
+struct hfl::niche_traits<color> : hfl::sentinel_niche<color, color::invalid>
+{
+};
+
+struct parse_error
+{
+};
+
+static_assert(sizeof(hfl::rs_option<hfl::non_null<int>>) == sizeof(int*));
+static_assert(sizeof(hfl::rs_option<hfl::non_null<const char>>) == sizeof(const char*));
+static_assert(sizeof(hfl::rs_option<color>) == sizeof(color));
+static_assert(sizeof(hfl::rs_result<hfl::non_null<int>, parse_error>) == sizeof(int*));
+static_assert(sizeof(hfl::rs_option<int*>) > sizeof(int*));
+static_assert(sizeof(hfl::rs_result<parse_error, color>) == sizeof(color));
+static_assert(sizeof(hfl::rs_option<int>) == 2 * sizeof(int));
+static_assert(sizeof(hfl::rs_result<std::uint32_t, std::uint8_t>) == 8);
+static_assert(sizeof(hfl::rs_result<std::uint16_t, std::uint8_t>) == 4);
+static_assert(sizeof(hfl::rs_result<int*, std::string>) == sizeof(std::string) + sizeof(void*));
+
+TEST(rs_storage_test, option_pointer_niche)
+{
+    int v = 3;
+    hfl::rs_option<hfl::non_null<int>> a{hfl::some<hfl::non_null<int>>{hfl::non_null<int>{&v}}};
+    hfl::rs_option<hfl::non_null<int>> b{hfl::none{}};
+    EXPECT_EQ(true, a.is_some());
+    EXPECT_EQ(&v, a.unwrap().get());
+    EXPECT_EQ(true, b.is_none());
+    EXPECT_THROW(b.unwrap(), hfl::unwrap_none_exception);
+}
+
+TEST(rs_storage_test, raw_pointer_keeps_null_payload)
+{
+    hfl::rs_option<int*> a{hfl::some<int*>{nullptr}};
+    EXPECT_EQ(true, a.is_some());
+    EXPECT_EQ(nullptr, a.unwrap());
+    hfl::rs_result<int*, parse_error> b{hfl::ok<int*>{nullptr}};
+    EXPECT_EQ(true, b.is_ok());
+    EXPECT_EQ(nullptr, b.unwrap());
+}
+
+TEST(rs_storage_test, option_enum_sentinel)
+{
+    hfl::rs_option<color> a{hfl::some<color>{color::blue}};
+    hfl::rs_option<color> b{hfl::none{}};
+    EXPECT_EQ(color::blue, a.unwrap());
+    EXPECT_EQ(true, b.is_none());
+    b = a;
+    EXPECT_EQ(true, b.is_some());
+}
+
+TEST(rs_storage_test, result_pointer_with_empty_error)
+{
+    int v = 7;
+    hfl::rs_result<int*, parse_error> a{hfl::ok<int*>{&v}};
+    static_assert(sizeof(a) > sizeof(int*));
+    EXPECT_EQ(true, a.is_ok());
+    EXPECT_EQ(7, *a.unwrap());
+    a.set_err(hfl::err<parse_error>{});
+    EXPECT_EQ(true, a.is_err());
+    int flag = 0;
+    a.match([&flag](const auto&) { flag = 1; }, [&flag](const auto&) { flag = 2; });
+    EXPECT_EQ(2, flag);
+    a.set_ok(hfl::ok<int*>{&v});
+    EXPECT_EQ(true, a.is_ok());
+    auto b = a.map([](int* p) { return *p * 2; });
+    EXPECT_EQ(14, b.unwrap());
+}
+
+TEST(rs_storage_test, result_empty_ok_with_enum_error)
+{
+    hfl::rs_result<parse_error, color> a{hfl::err<color>{color::green}};
+    EXPECT_EQ(true, a.is_err());
+    EXPECT_EQ(color::green, a.unwrap_err());
+    a.set_ok(hfl::ok<parse_error>{});
+    EXPECT_EQ(true, a.is_ok());
+}
+
+TEST(rs_storage_test, trivial_storage_switches_alternative)
+{
+    static_assert(std::is_same_v<hfl::rs_storage<hfl::ok<int>, hfl::err<double>>,
+                                 hfl::trivial_storage<hfl::ok<int>, hfl::err<double>>>);
+    hfl::rs_result<int, double> a{hfl::ok{3}};
+    a.set_err(hfl::err{1.5});
+    EXPECT_EQ(true, a.is_err());
+    EXPECT_EQ(1.5, a.unwrap_err());
+    hfl::rs_result<int, double> b = a;
+    a.set_ok(hfl::ok{4});
+    EXPECT_EQ(4, a.unwrap());
+    EXPECT_EQ(1.5, b.unwrap_err());
+    swap(a, b);
+    EXPECT_EQ(4, b.unwrap());
+}
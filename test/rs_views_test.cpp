@@ -0,0 +1,182 @@
+#include "rs_option.hpp"
+#include "rs_result.hpp"
+#include "rs_views.hpp"
+#include <gtest/gtest.h>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+using result = hfl::rs_result<int, std::string>;
+
+result parse(std::string_view s)
+{
+    int v = 0;
+    for (char c : s)
+    {
+        if (c < '0' or c > '9')
+        {
+            return result{hfl::err{std::string{s}}};
+        }
+        v = v * 10 + (c - '0');
+    }
+    return result{hfl::ok{v}};
+}
+
+std::vector<result> sample()
+{
+    std::vector<result> v;
+    v.emplace_back(hfl::ok{1});
+    v.emplace_back(hfl::err<std::string>{"bad"});
+    v.emplace_back(hfl::ok{3});
+    v.emplace_back(hfl::err<std::string>{"worse"});
+    v.emplace_back(hfl::ok{5});
+    return v;
+}
+
+template<typename Range>
+auto to_vector(Range&& range)
+{
+    std::vector<std::remove_cvref_t<std::ranges::range_reference_t<Range>>> out;
+    for (auto&& x : range)
+    {
+        out.push_back(x);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(rs_views_test, oks_and_errs)
+{
+    auto input = sample();
+    auto oks = input | hfl::views::oks;
+    static_assert(std::ranges::view<decltype(oks)>);
+    static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(oks)>, int&>);
+    EXPECT_EQ((std::vector<int>{1, 3, 5}), to_vector(oks));
+    EXPECT_EQ((std::vector<std::string>{"bad", "worse"}), to_vector(input | hfl::views::errs));
+
+    for (int& x : input | hfl::views::oks)
+    {
+        x *= 10;
+    }
+    EXPECT_EQ(30, input[2].unwrap());
+}
+
+TEST(rs_views_test, transform_ok_and_and_then)
+{
+    auto input = sample();
+    auto halve = [](int x) {
+        return x % 2 == 0 ? result{hfl::ok{x / 2}} : result{hfl::err{"odd " + std::to_string(x)}};
+    };
+    auto chained = input | hfl::views::transform_ok([](int x) { return x + 1; }) | hfl::views::and_then(halve);
+    static_assert(std::ranges::view<decltype(chained)>);
+    static_assert(std::is_same_v<std::ranges::range_value_t<decltype(chained)>, result>);
+
+    std::vector<std::string> errors = to_vector(chained | hfl::views::errs);
+    EXPECT_EQ((std::vector<std::string>{"bad", "worse"}), errors);
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), to_vector(chained | hfl::views::oks));
+
+    auto odd = input | hfl::views::and_then(halve) | hfl::views::errs;
+    EXPECT_EQ((std::vector<std::string>{"odd 1", "bad", "odd 3", "worse", "odd 5"}), to_vector(odd));
+}
+
+TEST(rs_views_test, take_while_ok)
+{
+    auto input = sample();
+    EXPECT_EQ((std::vector<int>{1}), to_vector(input | hfl::views::take_while_ok));
+    std::vector<std::optional<int>> opts{1, 2, std::nullopt, 4};
+    EXPECT_EQ((std::vector<int>{1, 2}), to_vector(opts | hfl::views::take_while_ok));
+}
+
+TEST(rs_views_test, options)
+{
+    std::vector<std::optional<int>> opts{1, std::nullopt, 3};
+    auto doubled = opts | hfl::views::transform_ok([](int x) { return x * 2; }) | hfl::views::oks;
+    EXPECT_EQ((std::vector<int>{2, 6}), to_vector(doubled));
+
+    std::vector<hfl::rs_option<int>> rs_opts{hfl::rs_option<int>{hfl::some{4}}, hfl::rs_option<int>{hfl::none{}}};
+    auto positive = [](int x) { return x > 0 ? hfl::rs_option<int>{hfl::some{x}} : hfl::rs_option<int>{hfl::none{}}; };
+    EXPECT_EQ((std::vector<int>{4}), to_vector(rs_opts | hfl::views::and_then(positive) | hfl::views::oks));
+}
+
+TEST(rs_views_test, try_transform_stops_at_first_error)
+{
+    std::vector<std::string_view> lines{"1", "22", "x3", "4"};
+    int calls = 0;
+    auto parsed = lines | hfl::views::try_transform([&calls](std::string_view s) {
+                      ++calls;
+                      return parse(s);
+                  });
+    static_assert(std::ranges::view<decltype(parsed)>);
+    static_assert(std::ranges::input_range<decltype(parsed)>);
+
+    int sum = 0;
+    for (int x : parsed)
+    {
+        sum += x;
+    }
+    EXPECT_EQ(23, sum);
+    EXPECT_EQ(3, calls);
+    ASSERT_EQ(true, parsed.error().has_value());
+    EXPECT_EQ("x3", *parsed.error());
+
+    std::vector<std::string_view> good{"7", "8"};
+    auto all = good | hfl::views::try_transform(parse);
+    EXPECT_EQ((std::vector<int>{7, 8}), to_vector(all));
+    EXPECT_EQ(false, all.error().has_value());
+}
+
+TEST(rs_views_test, filters_call_transform_once_per_element)
+{
+    auto input = sample();
+    int calls = 0;
+    auto counted = input | hfl::views::transform_ok([&calls](int x) {
+                       ++calls;
+                       return x * 2;
+                   });
+
+    EXPECT_EQ((std::vector<int>{2, 6, 10}), to_vector(counted | hfl::views::oks));
+    EXPECT_EQ(3, calls);
+
+    calls = 0;
+    EXPECT_EQ((std::vector<std::string>{"bad", "worse"}), to_vector(counted | hfl::views::errs));
+    EXPECT_EQ(3, calls);
+
+    calls = 0;
+    EXPECT_EQ((std::vector<int>{2}), to_vector(counted | hfl::views::take_while_ok));
+    EXPECT_EQ(1, calls);
+}
+
+TEST(rs_views_test, try_transform_iterators_survive_moving_the_view)
+{
+    std::vector<std::string_view> lines{"1", "2", "x"};
+    auto parsed = lines | hfl::views::try_transform(parse);
+    auto it = parsed.begin();
+    auto moved = std::move(parsed);
+    EXPECT_EQ(1, *it);
+    ++it;
+    EXPECT_EQ(2, *it);
+    ++it;
+    EXPECT_EQ(true, it == std::default_sentinel);
+    ASSERT_EQ(true, moved.error().has_value());
+    EXPECT_EQ("x", *moved.error());
+
+    auto copy = moved;
+    EXPECT_EQ((std::vector<int>{1, 2}), to_vector(copy));
+    EXPECT_EQ("x", *copy.error());
+}
+
+TEST(rs_views_test, closures_compose)
+{
+    auto pipeline = hfl::views::transform_ok([](int x) { return x * x; }) | hfl::views::oks;
+    auto input = sample();
+    EXPECT_EQ((std::vector<int>{1, 9, 25}), to_vector(input | pipeline));
+    EXPECT_EQ((std::vector<int>{1, 9, 25}), to_vector(pipeline(input)));
+    auto taken = input | hfl::views::oks | std::views::take(2);
+    EXPECT_EQ((std::vector<int>{1, 3}), to_vector(taken));
+}
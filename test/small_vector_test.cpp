@@ -0,0 +1,142 @@
+#include "small_vector.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+TEST(small_vector_test, stays_inline_up_to_n)
+{
+    hfl::small_vector<int, 4> v;
+    for (int i = 0; i < 4; ++i)
+    {
+        v.push_back(i);
+    }
+    EXPECT_EQ(true, v.is_inline());
+    EXPECT_EQ(4, v.size());
+    v.push_back(4);
+    EXPECT_EQ(false, v.is_inline());
+    EXPECT_EQ(8, v.capacity());
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(i, v[i]);
+    }
+}
+
+TEST(small_vector_test, copies_and_moves_inline_and_heap_elements)
+{
+    hfl::small_vector<std::string, 2> small{"a string too long for the small buffer"};
+    hfl::small_vector<std::string, 2> big{"x", "y", "z"};
+    EXPECT_EQ(false, big.is_inline());
+
+    auto small_copy = small;
+    auto big_copy = big;
+    EXPECT_EQ(small, small_copy);
+    EXPECT_EQ(big, big_copy);
+
+    auto small_moved = std::move(small_copy);
+    auto big_moved = std::move(big_copy);
+    EXPECT_EQ(true, small_copy.empty());
+    EXPECT_EQ(true, big_copy.empty());
+    EXPECT_EQ(small, small_moved);
+    EXPECT_EQ(big, big_moved);
+
+    small_moved = big;
+    EXPECT_EQ(big, small_moved);
+    big_moved = std::move(small);
+    EXPECT_EQ("a string too long for the small buffer", big_moved[0]);
+    EXPECT_EQ(true, big_moved.is_inline());
+}
+
+TEST(small_vector_test, move_only_elements)
+{
+    hfl::small_vector<std::unique_ptr<int>, 1> v;
+    v.emplace_back(std::make_unique<int>(1));
+    v.emplace_back(std::make_unique<int>(2));
+    v.emplace_back(std::make_unique<int>(3));
+    auto w = std::move(v);
+    EXPECT_EQ(3, *w.back());
+    w.pop_back();
+    EXPECT_EQ(2, w.size());
+    w.clear();
+    EXPECT_EQ(true, w.empty());
+}
+
+TEST(small_vector_test, push_back_of_own_element_when_full)
+{
+    hfl::small_vector<std::string, 2> strings{"a long string that does not fit the small buffer", "b"};
+    strings.push_back(strings[0]);
+    strings.emplace_back(strings[1]);
+    ASSERT_EQ(4u, strings.size());
+    EXPECT_EQ(strings[0], strings[2]);
+    EXPECT_EQ("b", strings[3]);
+
+    hfl::small_vector<int, 1> ints{7};
+    for (int i = 0; i < 6; ++i)
+    {
+        ints.push_back(ints.back());
+    }
+    EXPECT_EQ(7u, ints.size());
+    EXPECT_EQ(7, ints.back());
+}
+
+namespace
+{
+
+// Move-only, so growth has to use the move, which throws once the countdown
+// runs out.
+struct throwing_move
+{
+    static inline int live = 0;
+    static inline int moves_left = 0;
+
+    explicit throwing_move(int v) : value(v)
+    {
+        ++live;
+    }
+
+    throwing_move(throwing_move&& other) : value(other.value)
+    {
+        if (moves_left-- == 0)
+        {
+            throw std::runtime_error{"move"};
+        }
+        ++live;
+    }
+
+    throwing_move(const throwing_move&) = delete;
+
+    ~throwing_move()
+    {
+        --live;
+    }
+
+    int value;
+};
+
+} // namespace
+
+TEST(small_vector_test, growth_survives_a_throwing_move)
+{
+    {
+        hfl::small_vector<throwing_move, 2> v;
+        v.emplace_back(1);
+        v.emplace_back(2);
+        throwing_move::moves_left = 1;
+        EXPECT_THROW(v.emplace_back(3), std::runtime_error);
+        ASSERT_EQ(2u, v.size());
+        EXPECT_EQ(true, v.is_inline());
+        EXPECT_EQ(2, throwing_move::live);
+        EXPECT_EQ(1, v[0].value);
+        EXPECT_EQ(2, v[1].value);
+
+        throwing_move::moves_left = 0;
+        EXPECT_THROW(v.reserve(8), std::runtime_error);
+        EXPECT_EQ(2, throwing_move::live);
+
+        throwing_move::moves_left = 2;
+        v.emplace_back(3);
+        EXPECT_EQ(3, v[2].value);
+        EXPECT_EQ(3, throwing_move::live);
+    }
+    EXPECT_EQ(0, throwing_move::live);
+}
@@ -0,0 +1,97 @@
+#include "rs_option.hpp"
+#include "rs_result.hpp"
+#include "static_error.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+inline constexpr hfl::error_descriptor key_not_found{"key_not_found", "key {} not found in {}"};
+inline constexpr hfl::error_descriptor out_of_range{"out_of_range", "value out of range"};
+
+static hfl::rs_result<int, hfl::static_error> lookup(int key)
+{
+    if (key < 0)
+    {
+        return hfl::rs_result<int, hfl::static_error>{hfl::err<hfl::static_error>{out_of_range}};
+    }
+    if (key > 10)
+    {
+        return hfl::rs_result<int, hfl::static_error>{hfl::err<hfl::static_error>{key_not_found}};
+    }
+    return hfl::rs_result<int, hfl::static_error>{hfl::ok{key * key}};
+}
+
+static hfl::rs_result<int, hfl::error_with<int, const char*>> lookup_with(int key)
+{
+    if (key > 10)
+    {
+        return hfl::rs_result<int, hfl::error_with<int, const char*>>{
+            hfl::err<hfl::error_with<int, const char*>>{key_not_found(key, "table")}};
+    }
+    return hfl::rs_result<int, hfl::error_with<int, const char*>>{hfl::ok{key}};
+}
+
+TEST(static_error_test, static_error_is_one_word)
+{
+    static_assert(sizeof(hfl::static_error) == sizeof(void*));
+    static_assert(std::is_trivially_copyable_v<hfl::static_error>);
+    static_assert(sizeof(hfl::rs_option<hfl::static_error>) == sizeof(void*));
+    EXPECT_EQ(true, hfl::rs_option<hfl::static_error>{hfl::some<hfl::static_error>{out_of_range}}.is_some());
+}
+
+TEST(static_error_test, temporary_descriptors_are_rejected)
+{
+    static_assert(std::is_constructible_v<hfl::static_error, const hfl::error_descriptor&>);
+    static_assert(!std::is_constructible_v<hfl::static_error, hfl::error_descriptor>);
+    static_assert(!std::is_convertible_v<hfl::error_descriptor, hfl::static_error>);
+    static_assert(std::is_constructible_v<hfl::error_with<int>, const hfl::error_descriptor&, int>);
+    static_assert(!std::is_constructible_v<hfl::error_with<int>, hfl::error_descriptor, int>);
+    static_assert(std::is_invocable_v<const hfl::error_descriptor&, int>);
+    static_assert(!std::is_invocable_v<hfl::error_descriptor, int>);
+    EXPECT_EQ(true, hfl::static_error{key_not_found}.is(key_not_found));
+}
+
+TEST(static_error_test, static_error_identity)
+{
+    auto e = lookup(11).unwrap_err();
+    EXPECT_EQ(true, e.is(key_not_found));
+    EXPECT_EQ(true, e == key_not_found);
+    EXPECT_EQ(false, e == hfl::static_error{out_of_range});
+    EXPECT_EQ("key_not_found", e.name());
+    EXPECT_EQ("value out of range", lookup(-1).unwrap_err().message());
+}
+
+TEST(static_error_test, error_with_formats_lazily)
+{
+    auto e = lookup_with(42).unwrap_err();
+    EXPECT_EQ(true, e.is(key_not_found));
+    EXPECT_EQ(42, std::get<0>(e.args()));
+    EXPECT_EQ("key 42 not found in table", e.message());
+    hfl::static_error kind = e;
+    EXPECT_EQ(true, kind == key_not_found);
+    EXPECT_EQ("flag true, 2.5 and x{}", hfl::format_error("flag {}, {} and {}{}", true, 2.5, 'x'));
+}
+
+TEST(static_error_test, static_error_with_map_err_and_or_else)
+{
+    auto message = lookup(12).map_err([](hfl::static_error e) { return e.message(); });
+    EXPECT_EQ("key {} not found in {}", message.unwrap_err());
+
+    auto recovered = lookup(12).or_else([](hfl::static_error e) {
+        return e.is(key_not_found) ? hfl::rs_result<int, hfl::static_error>{hfl::ok{0}}
+                                   : hfl::rs_result<int, hfl::static_error>{hfl::err<hfl::static_error>{e}};
+    });
+    EXPECT_EQ(0, recovered.unwrap());
+    EXPECT_EQ(true, lookup(-3)
+                        .or_else([](hfl::static_error e) {
+                            return e.is(key_not_found)
+                                       ? hfl::rs_result<int, hfl::static_error>{hfl::ok{0}}
+                                       : hfl::rs_result<int, hfl::static_error>{hfl::err<hfl::static_error>{e}};
+                        })
+                        .unwrap_err()
+                        .is(out_of_range));
+
+    auto dropped = lookup_with(20).map_err([](const hfl::error_with<int, const char*>& e) -> hfl::static_error {
+        return e;
+    });
+    EXPECT_EQ(true, dropped.unwrap_err() == key_not_found);
+}
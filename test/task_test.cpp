@@ -0,0 +1,176 @@
+#include "task.hpp"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using int_task = hfl::task<int, std::string>;
+using int_result = hfl::rs_result<int, std::string>;
+
+static int_task value_task(int v)
+{
+    co_return v;
+}
+
+static int_task failing_task()
+{
+    co_return hfl::err<std::string>{"failed"};
+}
+
+static int_task on_executor(hfl::work_stealing_executor& ex, int v)
+{
+    co_await ex.schedule();
+    EXPECT_EQ(true, ex.running_in_this_thread());
+    co_return v * 2;
+}
+
+static int_task sum_of(hfl::work_stealing_executor& ex, int a, int b)
+{
+    int_result x = co_await on_executor(ex, a);
+    const int y = co_await (co_await on_executor(ex, b));
+    co_return co_await x + y;
+}
+
+static int_task propagates(hfl::work_stealing_executor& ex)
+{
+    const int a = co_await (co_await on_executor(ex, 1));
+    const int b = co_await (co_await failing_task());
+    co_return a + b;
+}
+
+TEST(task_test, sync_wait_without_executor)
+{
+    EXPECT_EQ(3, hfl::sync_wait(value_task(3)).unwrap());
+    EXPECT_EQ("failed", hfl::sync_wait(failing_task()).unwrap_err());
+}
+
+TEST(task_test, task_on_executor)
+{
+    hfl::work_stealing_executor ex{4};
+    EXPECT_EQ(false, ex.running_in_this_thread());
+    EXPECT_EQ(10, hfl::sync_wait(on_executor(ex, 5)).unwrap());
+    EXPECT_EQ(14, hfl::sync_wait(sum_of(ex, 3, 4)).unwrap());
+    EXPECT_EQ("failed", hfl::sync_wait(propagates(ex)).unwrap_err());
+}
+
+TEST(task_test, task_continuations)
+{
+    hfl::work_stealing_executor ex{2};
+    auto chained = on_executor(ex, 5)
+                       .map([](int v) { return std::to_string(v); })
+                       .and_then([](std::string s) { return hfl::rs_result<size_t, std::string>{hfl::ok{s.size()}}; })
+                       .and_then([&ex](size_t n) { return on_executor(ex, static_cast<int>(n)); });
+    EXPECT_EQ(4, hfl::sync_wait(std::move(chained)).unwrap());
+
+    int calls{0};
+    auto skipped = failing_task().map([&calls](int v) {
+        ++calls;
+        return v;
+    });
+    EXPECT_EQ("failed", hfl::sync_wait(std::move(skipped)).unwrap_err());
+    EXPECT_EQ(0, calls);
+}
+
+static int_task throws_task()
+{
+    co_await value_task(1);
+    throw std::runtime_error{"boom"};
+}
+
+TEST(task_test, task_exception)
+{
+    EXPECT_THROW(hfl::sync_wait(throws_task()), std::runtime_error);
+}
+
+TEST(task_test, executor_runs_all_posted_work)
+{
+    std::atomic<int> count{0};
+    {
+        hfl::work_stealing_executor ex{4};
+        for (int i = 0; i < 1'000; ++i)
+        {
+            ex.execute([&ex, &count] {
+                // Work posted from a worker lands on its own deque, the
+                // others have to steal it.
+                for (int j = 0; j < 10; ++j)
+                {
+                    ex.execute([&count] { ++count; });
+                }
+            });
+        }
+    }
+    EXPECT_EQ(10'000, count.load());
+}
+
+TEST(task_test, executor_shutdown_drains_every_queue)
+{
+    for (int round = 0; round < 20; ++round)
+    {
+        std::atomic<int> count{0};
+        {
+            hfl::work_stealing_executor ex{8};
+            for (int i = 0; i < 50; ++i)
+            {
+                ex.execute([&ex, &count] {
+                    for (int j = 0; j < 20; ++j)
+                    {
+                        ex.execute([&count] { ++count; });
+                    }
+                });
+            }
+        }
+        EXPECT_EQ(1'000, count.load());
+    }
+}
+
+TEST(task_test, work_stealing_deque)
+{
+    hfl::work_stealing_deque<int> deque{2};
+    for (int i = 0; i < 10; ++i)
+    {
+        deque.push(i);
+    }
+    EXPECT_EQ(0, deque.steal().value());
+    EXPECT_EQ(9, deque.pop().value());
+    EXPECT_EQ(1, deque.steal().value());
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> stolen{0};
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t)
+    {
+        thieves.emplace_back([&] {
+            int count{0};
+            while (!stop.load())
+            {
+                if (deque.steal())
+                {
+                    ++count;
+                }
+            }
+            stolen += count;
+        });
+    }
+    int popped{0};
+    for (int i = 0; i < 100'000; ++i)
+    {
+        deque.push(i);
+        if (i % 3 == 0 and deque.pop())
+        {
+            ++popped;
+        }
+    }
+    while (deque.pop())
+    {
+        ++popped;
+    }
+    stop = true;
+    for (auto& t : thieves)
+    {
+        t.join();
+    }
+    const int total = popped + stolen.load();
+    EXPECT_EQ(100'000 + 7, total);
+}
@@ -0,0 +1,149 @@
+#include "traverse.hpp"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using parse_result = hfl::rs_result<int, std::string>;
+
+static std::vector<int> iota_vector(int n)
+{
+    std::vector<int> values(n);
+    std::iota(values.begin(), values.end(), 0);
+    return values;
+}
+
+TEST(traverse_test, traverse_ok)
+{
+    const auto input = iota_vector(10);
+    auto res = hfl::traverse(input, [](int v) { return parse_result{hfl::ok{v * 2}}; });
+    EXPECT_EQ(18, res.unwrap()[9]);
+    EXPECT_EQ(10u, res.unwrap().size());
+}
+
+TEST(traverse_test, traverse_stops_at_first_error)
+{
+    int calls{0};
+    const auto input = iota_vector(10);
+    auto res = hfl::traverse(input, [&calls](int v) {
+        ++calls;
+        return v == 4 ? parse_result{hfl::err<std::string>{"4"}} : parse_result{hfl::ok{v}};
+    });
+    EXPECT_EQ("4", res.unwrap_err());
+    EXPECT_EQ(5, calls);
+}
+
+TEST(traverse_test, parallel_traverse_ok)
+{
+    const auto input = iota_vector(100'000);
+    auto res = hfl::parallel_traverse(input, [](int v) { return parse_result{hfl::ok{v + 1}}; }, 4);
+    const auto& values = res.unwrap_ref();
+    ASSERT_EQ(input.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<int>(i) + 1, values[i]);
+    }
+}
+
+TEST(traverse_test, parallel_traverse_returns_first_error_in_index_order)
+{
+    const auto input = iota_vector(100'000);
+    for (int round = 0; round < 20; ++round)
+    {
+        std::atomic<size_t> calls{0};
+        auto res = hfl::parallel_traverse(
+            input,
+            [&calls](int v) {
+                ++calls;
+                return v % 9'973 == 9'972 ? parse_result{hfl::err<std::string>{std::to_string(v)}}
+                                          : parse_result{hfl::ok{v}};
+            },
+            8);
+        ASSERT_EQ("9972", res.unwrap_err());
+        EXPECT_LT(calls.load(), input.size());
+    }
+}
+
+TEST(traverse_test, parallel_traverse_bool_output)
+{
+    const auto input = iota_vector(1'000);
+    auto res = hfl::parallel_traverse(
+        input, [](int v) { return hfl::rs_result<bool, std::string>{hfl::ok{v % 2 == 0}}; }, 4);
+    const auto& values = res.unwrap_ref();
+    EXPECT_EQ(500, std::count(values.begin(), values.end(), true));
+}
+
+TEST(traverse_test, parallel_traverse_all_collects_errors)
+{
+    const auto input = iota_vector(10'000);
+    auto res = hfl::parallel_traverse_all(
+        input,
+        [](int v) { return v % 1'000 == 7 ? parse_result{hfl::err<std::string>{"bad"}} : parse_result{hfl::ok{v}}; },
+        4);
+    const auto& errors = res.unwrap_err_ref();
+    ASSERT_EQ(10u, errors.size());
+    for (size_t i = 0; i < errors.size(); ++i)
+    {
+        EXPECT_EQ(i * 1'000 + 7, errors[i].first);
+        EXPECT_EQ("bad", errors[i].second);
+    }
+    EXPECT_EQ(true, hfl::parallel_traverse_all(input, [](int v) { return parse_result{hfl::ok{v}}; }).is_ok());
+}
+
+TEST(traverse_test, parallel_traverse_rethrows)
+{
+    const auto input = iota_vector(1'000);
+    EXPECT_THROW(hfl::parallel_traverse(
+                     input,
+                     [](int v) {
+                         if (v == 500)
+                         {
+                             throw std::runtime_error{"boom"};
+                         }
+                         return parse_result{hfl::ok{v}};
+                     },
+                     4),
+                 std::runtime_error);
+}
+
+TEST(traverse_test, parallel_traverse_runs_on_the_shared_pool)
+{
+    const auto input = iota_vector(64);
+    std::atomic<bool> pool_joined{false};
+    auto res = hfl::parallel_traverse(
+        input,
+        [&pool_joined](int v) {
+            if (hfl::default_parallel_executor().running_in_this_thread())
+            {
+                pool_joined = true;
+            }
+            else
+            {
+                // Hold the caller until a pool worker picked up a chunk.
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                while (!pool_joined and std::chrono::steady_clock::now() < deadline)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            return parse_result{hfl::ok{v}};
+        },
+        2);
+    EXPECT_EQ(true, res.is_ok());
+    EXPECT_EQ(true, pool_joined.load());
+}
+
+TEST(traverse_test, nested_parallel_traverse_completes)
+{
+    const auto input = iota_vector(64);
+    auto res = hfl::parallel_traverse(input, [&input](int v) {
+        auto inner = hfl::parallel_traverse(input, [v](int w) { return parse_result{hfl::ok{v + w}}; });
+        return parse_result{hfl::ok{inner.unwrap_unchecked().back()}};
+    });
+    ASSERT_EQ(true, res.is_ok());
+    EXPECT_EQ(63 + 63, res.unwrap_unchecked().back());
+}
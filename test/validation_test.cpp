@@ -0,0 +1,105 @@
+#include "rs_result.hpp"
+#include "validation.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using field = hfl::rs_result<int, std::string>;
+
+field check_range(const char* name, int v, int lo, int hi)
+{
+    if (v < lo or v > hi)
+    {
+        return field{hfl::err{std::string{name} + " out of range"}};
+    }
+    return field{hfl::ok{v}};
+}
+
+struct date
+{
+    int m_year;
+    int m_month;
+    int m_day;
+};
+
+// Neither copyable nor movable, so it can only be built in place.
+struct pinned
+{
+    explicit pinned(int a, int b) : m_sum(a + b)
+    {
+    }
+
+    pinned(const pinned&) = delete;
+    pinned& operator=(const pinned&) = delete;
+
+    int m_sum;
+};
+
+} // namespace
+
+TEST(validation_test, all_valid_inputs_reach_the_function)
+{
+    auto d = hfl::validate_into<date>(check_range("year", 2024, 1, 9999), check_range("month", 2, 1, 12),
+                                      check_range("day", 29, 1, 31));
+    ASSERT_EQ(true, d.is_valid());
+    EXPECT_EQ(2024, d.value().m_year);
+    EXPECT_EQ(29, d.value().m_day);
+
+    auto sum = hfl::validate([](int a, int b) { return a + b; }, field{hfl::ok{1}}, field{hfl::ok{2}});
+    EXPECT_EQ(3, sum.value());
+}
+
+TEST(validation_test, every_error_is_collected_in_order)
+{
+    int calls = 0;
+    auto d = hfl::validate(
+        [&calls](int y, int m, int day) {
+            ++calls;
+            return date{y, m, day};
+        },
+        check_range("year", 0, 1, 9999), check_range("month", 2, 1, 12), check_range("day", 40, 1, 31));
+    EXPECT_EQ(0, calls);
+    ASSERT_EQ(true, d.is_invalid());
+    EXPECT_EQ(2, d.errors().size());
+    EXPECT_EQ("year out of range", d.errors()[0]);
+    EXPECT_EQ("day out of range", d.errors()[1]);
+    EXPECT_EQ(true, d.errors().is_inline());
+}
+
+TEST(validation_test, errors_spill_past_the_inline_capacity)
+{
+    auto bad = [](int i) { return field{hfl::err{"field " + std::to_string(i)}}; };
+    auto v = hfl::validate<2>([](int, int, int, int) { return 0; }, bad(0), bad(1), field{hfl::ok{2}}, bad(3));
+    ASSERT_EQ(3, v.errors().size());
+    EXPECT_EQ(false, v.errors().is_inline());
+    EXPECT_EQ("field 3", v.errors()[2]);
+}
+
+TEST(validation_test, validations_nest)
+{
+    using date_validation = hfl::validation<date, std::string>;
+    date_validation bad_date = hfl::validate_into<date>(check_range("year", -1, 1, 9999),
+                                                        check_range("month", 13, 1, 12), check_range("day", 1, 1, 31));
+    auto event = hfl::validate([](const date& d, int hour) { return d.m_year * 100 + hour; }, bad_date,
+                               check_range("hour", 25, 0, 23));
+    std::vector<std::string> errors(event.errors().begin(), event.errors().end());
+    EXPECT_EQ((std::vector<std::string>{"year out of range", "month out of range", "hour out of range"}), errors);
+
+    auto good = hfl::validate([](const date& d, int hour) { return d.m_year * 100 + hour; },
+                              hfl::validate_into<date>(field{hfl::ok{2000}}, field{hfl::ok{1}}, field{hfl::ok{1}}),
+                              check_range("hour", 12, 0, 23));
+    EXPECT_EQ(200012, good.value());
+    EXPECT_EQ(200012, std::move(good).into_result().unwrap());
+}
+
+TEST(validation_test, value_is_built_in_place)
+{
+    auto p = hfl::validate([](int a, int b) { return pinned{a, b}; }, field{hfl::ok{1}}, field{hfl::ok{2}});
+    EXPECT_EQ(3, p.value().m_sum);
+
+    hfl::validation<int, std::string> single{hfl::err<std::string>{"only"}};
+    EXPECT_EQ(1, single.errors().size());
+}